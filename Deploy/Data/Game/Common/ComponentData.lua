@@ -0,0 +1,49 @@
+local ffi = require("ffi")
+
+-- Component data layouts.
+-- Must match the data structures declared in engine headers.
+ffi.cdef[[
+    typedef struct
+    {
+        float x;
+        float y;
+    } Vec2Data;
+    
+    typedef struct
+    {
+        Vec2Data position;
+        Vec2Data scale;
+        float rotation;
+    } TransformData;
+]]
+
+-- Direct access to component data.
+-- Fields are read and written in place without going through bindings.
+-- Every looked up pointer is a cdata object, so LookupTransforms()
+-- allocates one for each entity.
+-- Pointers are only valid until the end of the current update; do not store them.
+ComponentData = {}
+
+local TransformDataPointer = ffi.typeof("TransformData*")
+
+function ComponentData.LookupTransform(entity)
+    local data = ComponentSystem:LookupTransformData(entity)
+    
+    if data == nil then
+        return nil
+    end
+    
+    return ffi.cast(TransformDataPointer, data)
+end
+
+function ComponentData.LookupTransforms(entities)
+    local data = ComponentSystem:LookupTransformsData(entities)
+    
+    for i = 1, #entities do
+        if data[i] ~= nil then
+            data[i] = ffi.cast(TransformDataPointer, data[i])
+        end
+    end
+    
+    return data
+end
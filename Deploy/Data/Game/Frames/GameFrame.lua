@@ -17,6 +17,9 @@ function GameFrame:New()
         System.Quit()
     end
     
+    -- Create entity prefabs.
+    Factory.CreatePrefabs()
+    
     -- Create entity bounds.
     Factory.CreateBounds()
     
@@ -25,7 +28,7 @@ function GameFrame:New()
     
     -- Setup spawn system.
     local spawnArea = Vec4(1024.0 + 100.0, 50.0, 1024.0 + 100.0, 576.0 - 50.0)
-    SpawnSystem:AddSpawn(Factory.CreateEnemy, spawnArea, 0.5, 1.0)
+    SpawnSystem:AddPrefabSpawn(PrefabSystem:GetPrefab("Enemy"), spawnArea, 0.5, 1.0)
     
     return self
 end
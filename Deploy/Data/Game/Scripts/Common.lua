@@ -1,30 +1,5 @@
 Scripts = Scripts or {}
 
--- Constant velocity script.
-local ConstantVelocity = {}
-ConstantVelocity.__index = ConstantVelocity
-Scripts.ConstantVelocity = ConstantVelocity
-
-function ConstantVelocity:New(velocity)
-    local self = {}
-    self.velocity = velocity
-    
-    return setmetatable(self, ConstantVelocity)
-end
-
-function ConstantVelocity:OnUpdate(entitySelf, timeDelta)
-    -- Get transform component.
-    local transform = ComponentSystem:LookupTransform(entitySelf)
-    
-    -- Update position.
-    local position = transform:GetPosition()
-    position.x = position.x + self.velocity.x * timeDelta
-    position.y = position.y + self.velocity.y * timeDelta
-    transform:SetPosition(position)
-end
-
-setmetatable(ConstantVelocity, { __call = ConstantVelocity.New })
-
 -- Destroy on death script.
 local DestroyOnDeath = {}
 DestroyOnDeath.__index = DestroyOnDeath
@@ -96,19 +71,21 @@ function FlashOnDamage:New()
     return setmetatable(self, FlashOnDamage)
 end
 
-function FlashOnDamage:OnUpdate(entitySelf, timeDelta)
-    -- Don't do anything if not needed.
-    if self.timer == 0.0 then
-        return
+function FlashOnDamage.OnUpdateBatch(scripts, entities, timeDelta)
+    for i, entitySelf in ipairs(entities) do
+        local self = scripts[i]
+        
+        -- Don't do anything if not needed.
+        if self.timer ~= 0.0 then
+            -- Update render component.
+            local render = ComponentSystem:LookupRender(entitySelf)
+            render:SetEmissionColor(Vec3(1.0, 1.0, 1.0))
+            render:SetEmissionPower(self.timer)
+            
+            -- Update blink time.
+            self.timer = math.max(0.0, self.timer - timeDelta)
+        end
     end
-    
-    -- Update render component.
-    local render = ComponentSystem:LookupRender(entitySelf)
-    render:SetEmissionColor(Vec3(1.0, 1.0, 1.0))
-    render:SetEmissionPower(self.timer)
-    
-    -- Update blink time.
-    self.timer = math.max(0.0, self.timer - timeDelta)
 end
 
 function FlashOnDamage:OnDamaged(entitySelf, value, alive)
@@ -54,8 +54,8 @@ function Player:OnUpdate(entitySelf, timeDelta)
         -- Normalize movement vector.
         movement:Normalize()
     
-        -- Calculate new position.
-        local position = transform:GetPosition()
+        -- Update position in place.
+        local position = ComponentData.LookupTransform(entitySelf).position
         position.x = position.x + movement.x * 400.0 * timeDelta
         position.y = position.y + movement.y * 400.0 * timeDelta
         
@@ -63,9 +63,6 @@ function Player:OnUpdate(entitySelf, timeDelta)
         local boundingBox = collision:GetBoundingBox()
         position.x = math.max(0.0 - boundingBox.x, math.min(position.x, 1024.0 - boundingBox.z))
         position.y = math.max(0.0 - boundingBox.y, math.min(position.y, 576.0 - boundingBox.w))
-        
-        -- Set new position.
-        transform:SetPosition(position)
     end
 end
 
@@ -11,12 +11,20 @@ function Projectile:New(damage)
     return setmetatable(self, Projectile)
 end
 
-function Projectile:OnCollision(collisionSelf, collisionOther)
-    -- Apply damage to other entity.
-    HealthSystem:Damage(collisionOther.entity, self.damage)
-    
-    -- Destroy projectile.
-    EntitySystem:DestroyEntity(collisionSelf.entity)
+function Projectile.OnCollisionBatch(contacts)
+    for i, contact in ipairs(contacts) do
+        local entitySelf = contact.self.entity
+        local entityOther = contact.other.entity
+        
+        -- Skip contacts of entities destroyed or killed by earlier contacts.
+        if EntitySystem:IsHandleValid(entitySelf) and HealthSystem:IsAlive(entityOther) then
+            -- Apply damage to other entity.
+            HealthSystem:Damage(entityOther, contact.script.damage)
+            
+            -- Destroy projectile.
+            EntitySystem:DestroyEntity(entitySelf)
+        end
+    end
 end
 
 setmetatable(Projectile, { __call = Projectile.New })
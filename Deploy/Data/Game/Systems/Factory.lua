@@ -1,4 +1,5 @@
 require("Defines.Collision")
+require("Common.ComponentData")
 require("Scripts.Common")
 require("Scripts.Player")
 require("Scripts.Enemy")
@@ -75,53 +76,73 @@ function Factory.CreatePlayer()
     render:SetDiffuseColor(Vec4(0.0, 1.0, 0.0, 1.0))
 end
 
-function Factory.CreateEnemy(position)
-    local entity = EntitySystem:CreateEntity()
+function Factory.CreatePrefabs()
+    -- Create enemy prefab.
+    local enemy = PrefabSystem:CreatePrefab("Enemy")
     
-    local transform = ComponentSystem:CreateTransform(entity)
-    transform:SetPosition(position)
+    local transform = enemy:CreateTransform()
     transform:SetScale(Vec2(50.0, 50.0))
     transform:SetRotation(0.0)
     
-    local health = ComponentSystem:CreateHealth(entity)
+    local health = enemy:CreateHealth()
     health:SetMaximumHealth(30)
     health:SetCurrentHealth(30)
     
-    local collision = ComponentSystem:CreateCollision(entity)
+    local collision = enemy:CreateCollision()
     collision:SetBoundingBox(Vec4(-25.0, -25.0, 25.0, 25.0))
     collision:SetType(CollisionTypes.Enemy)
     collision:SetMask(CollisionTypes.Player)
     
-    local script = ComponentSystem:CreateScript(entity)
+    local velocity = enemy:CreateVelocity()
+    velocity:SetLinearVelocity(Vec2(-150.0, 0.0))
+    
+    local script = enemy:CreateScript()
     script:AddScript(Scripts.Enemy())
-    script:AddScript(Scripts.ConstantVelocity(Vec2(-150.0, 0.0)))
     script:AddScript(Scripts.DamageOnCollision(5, 0.2))
     script:AddScript(Scripts.FlashOnDamage())
     script:AddScript(Scripts.DestroyOnDeath())
     
-    local render = ComponentSystem:CreateRender(entity)
+    local render = enemy:CreateRender()
     render:SetDiffuseColor(Vec4(1.0, 0.0, 0.0, 1.0))
 end
 
+function Factory.CreateEnemy(position)
+    return PrefabSystem:InstantiateAt(PrefabSystem:GetPrefab("Enemy"), position)
+end
+
 function Factory.CreateProjectile(position, velocity, damage, mask)
-    local entity = EntitySystem:CreateEntity()
-    
-    local transform = ComponentSystem:CreateTransform(entity)
-    transform:SetPosition(position)
-    transform:SetScale(Vec2(30.0, 30.0))
-    transform:SetRotation(0.0)
-    
-    local collision = ComponentSystem:CreateCollision(entity)
-    collision:SetBoundingBox(Vec4(-15.0, -15.0, 15.0, 15.0))
-    collision:SetType(CollisionTypes.Projectile)
-    collision:SetMask(mask)
-    
-    local script = ComponentSystem:CreateScript(entity)
-    script:AddScript(Scripts.Projectile(damage))
-    script:AddScript(Scripts.ConstantVelocity(velocity))
-    
-    local render = ComponentSystem:CreateRender(entity)
-    render:SetDiffuseColor(Vec4(1.0, 1.0, 0.0, 1.0))
+    Factory.CreateProjectiles({ position }, velocity, damage, mask)
+end
+
+function Factory.CreateProjectiles(positions, velocity, damage, mask)
+    local entities = EntitySystem:CreateEntities(#positions)
+    
+    local transforms = ComponentSystem:CreateTransforms(entities)
+    local velocities = ComponentSystem:CreateVelocities(entities)
+    local collisions = ComponentSystem:CreateCollisions(entities)
+    local scripts = ComponentSystem:CreateScripts(entities)
+    local renders = ComponentSystem:CreateRenders(entities)
+    
+    for i, position in ipairs(positions) do
+        local transform = transforms[i]
+        transform:SetPosition(position)
+        transform:SetScale(Vec2(30.0, 30.0))
+        transform:SetRotation(0.0)
+        
+        velocities[i]:SetLinearVelocity(velocity)
+        
+        local collision = collisions[i]
+        collision:SetBoundingBox(Vec4(-15.0, -15.0, 15.0, 15.0))
+        collision:SetType(CollisionTypes.Projectile)
+        collision:SetMask(mask)
+        collision:SetFlags(bit.bor(CollisionFlags.Default, CollisionFlags.FastMoving))
+        
+        local script = scripts[i]
+        script:AddScript(Scripts.Projectile(damage))
+        
+        local render = renders[i]
+        render:SetDiffuseColor(Vec4(1.0, 1.0, 0.0, 1.0))
+    end
 end
 
 function Factory.CreateHealthPickup(position, heal)
@@ -132,6 +153,9 @@ function Factory.CreateHealthPickup(position, heal)
     transform:SetScale(Vec2(40.0, 40.0))
     transform:SetRotation(0.0)
     
+    local velocity = ComponentSystem:CreateVelocity(entity)
+    velocity:SetLinearVelocity(Vec2(-100.0, 0.0))
+    
     local collision = ComponentSystem:CreateCollision(entity)
     collision:SetBoundingBox(Vec4(-20.0, -20.0, 20.0, 20.0))
     collision:SetType(CollisionTypes.Pickup)
@@ -139,7 +163,6 @@ function Factory.CreateHealthPickup(position, heal)
     
     local script = ComponentSystem:CreateScript(entity)
     script:AddScript(Scripts.HealthPickup(heal))
-    script:AddScript(Scripts.ConstantVelocity(Vec2(-100.0, 0)))
     
     local render = ComponentSystem:CreateRender(entity)
     render:SetDiffuseColor(Vec4(0.6, 1.0, 0.6, 1.0))
@@ -0,0 +1,19 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    // Accumulated results of measured work.
+    volatile double consumed = 0.0;
+}
+
+void Benchmark::Consume(double value)
+{
+    consumed = consumed + value;
+}
+
+void Benchmark::Report(const std::string& suite, const std::string& name, double value, const std::string& unit)
+{
+    std::cout << std::left << std::setw(20) << suite << std::setw(48) << name;
+    std::cout << std::right << std::fixed << std::setprecision(2) << std::setw(14) << value << " " << unit << std::endl;
+}
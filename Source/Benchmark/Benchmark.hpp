@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+//
+// Benchmark
+//  Helpers shared by benchmark suites. Every measurement is printed
+//  on a separate line, so results can be compared between builds.
+//
+//  Example usage:
+//      double time = Benchmark::Measure(100, [&]() { /* ... */ });
+//      Benchmark::Report("Suite", "Measurement", time / count, "ns/op");
+//
+
+namespace Benchmark
+{
+    // Type declarations.
+    typedef std::chrono::high_resolution_clock Clock;
+
+    // Keeps a result alive, so the work producing it can't be optimized away.
+    void Consume(double value);
+
+    // Runs a function repeatedly and returns the average time of a run in nanoseconds.
+    template<typename Function>
+    double Measure(int runs, Function function)
+    {
+        assert(runs > 0);
+
+        // Warm up caches and allocations.
+        function();
+
+        // Measure repeated runs.
+        Clock::time_point start = Clock::now();
+
+        for(int i = 0; i < runs; ++i)
+        {
+            function();
+        }
+
+        Clock::time_point end = Clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / runs;
+    }
+
+    // Prints a single measurement.
+    void Report(const std::string& suite, const std::string& name, double value, const std::string& unit);
+}
+
+// Benchmark suites.
+void BenchmarkComponentPool();
+void BenchmarkJobSystem();
+void BenchmarkSweepAndPrune();
+void BenchmarkBoundingBoxBatch();
+void BenchmarkEntitySystem();
+void BenchmarkDispatcher();
+void BenchmarkDelegate();
+void BenchmarkEventSystem();
+void BenchmarkScript();
+void BenchmarkComponentData();
@@ -0,0 +1,40 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    // List of benchmark suites.
+    struct Suite
+    {
+        const char* name;
+        void (*function)();
+    };
+
+    const Suite Suites[] =
+    {
+        { "ComponentPool", &BenchmarkComponentPool },
+        { "JobSystem", &BenchmarkJobSystem },
+        { "SweepAndPrune", &BenchmarkSweepAndPrune },
+        { "BoundingBoxBatch", &BenchmarkBoundingBoxBatch },
+        { "EntitySystem", &BenchmarkEntitySystem },
+        { "Dispatcher", &BenchmarkDispatcher },
+        { "Delegate", &BenchmarkDelegate },
+        { "EventSystem", &BenchmarkEventSystem },
+        { "Script", &BenchmarkScript },
+        { "ComponentData", &BenchmarkComponentData },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    // Run suites named on the command line or all of them.
+    for(const Suite& suite : Suites)
+    {
+        if(argc > 1 && std::find(argv + 1, argv + argc, std::string(suite.name)) == argv + argc)
+            continue;
+
+        suite.function();
+    }
+
+    return 0;
+}
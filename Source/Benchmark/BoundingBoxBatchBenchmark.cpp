@@ -0,0 +1,100 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Game/Collision/BoundingBoxBatch.hpp"
+
+namespace
+{
+    // Number of boxes each tested box is compared against.
+    const int BoxCount = 4096;
+
+    // Number of tested boxes.
+    const int QueryCount = 256;
+
+    // Tests a box against a list of boxes one at a time.
+    uint32_t IntersectScalar(const glm::vec4& box, const std::vector<glm::vec4>& boxes, int index)
+    {
+        uint32_t mask = 0;
+
+        for(int i = 0; i < BoundingBoxBatch::Width; ++i)
+        {
+            const glm::vec4& other = boxes[index + i];
+
+            if(!(box.x > other.z || box.z < other.x || box.y > other.w || box.w < other.y))
+            {
+                mask |= 1 << i;
+            }
+        }
+
+        return mask;
+    }
+}
+
+void BenchmarkBoundingBoxBatch()
+{
+    // Create random boxes, so results of tests can't be predicted.
+    std::mt19937 random(4);
+    std::uniform_real_distribution<float> position(0.0f, 1024.0f);
+    std::uniform_real_distribution<float> size(8.0f, 64.0f);
+
+    auto CreateBox = [&]()
+    {
+        glm::vec2 minimum(position(random), position(random));
+        return glm::vec4(minimum, minimum + glm::vec2(size(random), size(random)));
+    };
+
+    std::vector<glm::vec4> boxes;
+    BoundingBoxBatch batch;
+
+    for(int i = 0; i < BoxCount; ++i)
+    {
+        boxes.push_back(CreateBox());
+        batch.Add(boxes.back());
+    }
+
+    batch.Finalize();
+
+    std::vector<glm::vec4> queries;
+
+    for(int i = 0; i < QueryCount; ++i)
+    {
+        queries.push_back(CreateBox());
+    }
+
+    // Measure testing boxes one by one.
+    double scalar = Benchmark::Measure(20, [&]()
+    {
+        uint32_t hits = 0;
+
+        for(const glm::vec4& query : queries)
+        {
+            for(int i = 0; i < BoxCount; i += BoundingBoxBatch::Width)
+            {
+                hits += IntersectScalar(query, boxes, i) != 0;
+            }
+        }
+
+        Benchmark::Consume(hits);
+    });
+
+    // Measure testing four boxes at once.
+    double batched = Benchmark::Measure(20, [&]()
+    {
+        uint32_t hits = 0;
+
+        for(const glm::vec4& query : queries)
+        {
+            for(int i = 0; i < BoxCount; i += BoundingBoxBatch::Width)
+            {
+                hits += batch.Intersect(query, i) != 0;
+            }
+        }
+
+        Benchmark::Consume(hits);
+    });
+
+    double pairs = (double)BoxCount * QueryCount;
+
+    Benchmark::Report("BoundingBoxBatch", "Scalar tests", pairs / scalar * 1000.0, "Mpairs/s");
+    Benchmark::Report("BoundingBoxBatch", "Batched tests", pairs / batched * 1000.0, "Mpairs/s");
+}
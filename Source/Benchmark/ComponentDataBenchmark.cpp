@@ -0,0 +1,142 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Game/Transform/TransformComponent.hpp"
+
+namespace
+{
+    // Number of entities with updated positions.
+    const int EntityCount = 10000;
+
+    // Position updates through bindings and through FFI, like in game scripts.
+    const char* Script =
+        "local ffi = require('ffi') "
+        "ffi.cdef[[ "
+        "    typedef struct { float x; float y; } Vec2Data; "
+        "    typedef struct { Vec2Data position; Vec2Data scale; float rotation; } TransformData; "
+        "]] "
+        "local TransformDataPointer = ffi.typeof('TransformData*') "
+        "function UpdateBindings(transforms, timeDelta) "
+        "    for i = 1, #transforms do "
+        "        local transform = transforms[i] "
+        "        local position = transform:GetPosition() "
+        "        position.x = position.x + timeDelta "
+        "        position.y = position.y + timeDelta "
+        "        transform:SetPosition(position) "
+        "    end "
+        "end "
+        "function UpdateData(data, timeDelta) "
+        "    for i = 1, #data do "
+        "        local transform = ffi.cast(TransformDataPointer, data[i]) "
+        "        transform.position.x = transform.position.x + timeDelta "
+        "        transform.position.y = transform.position.y + timeDelta "
+        "    end "
+        "end "
+        "function CastData(data) "
+        "    local pointers = {} "
+        "    for i = 1, #data do "
+        "        pointers[i] = ffi.cast(TransformDataPointer, data[i]) "
+        "    end "
+        "    return pointers "
+        "end "
+        "function UpdateCastData(pointers, timeDelta) "
+        "    for i = 1, #pointers do "
+        "        local transform = pointers[i] "
+        "        transform.position.x = transform.position.x + timeDelta "
+        "        transform.position.y = transform.position.y + timeDelta "
+        "    end "
+        "end ";
+
+    // Calls a global script function and checks for errors.
+    void CallScript(lua_State* state, const char* name, const Lua::LuaRef& list, float timeDelta)
+    {
+        lua_getglobal(state, name);
+        list.push(state);
+        lua_pushnumber(state, timeDelta);
+
+        if(lua_pcall(state, 2, 0, 0) != 0)
+        {
+            Log() << "Lua error - " << lua_tostring(state, -1) << ".";
+            lua_pop(state, 1);
+        }
+    }
+}
+
+void BenchmarkComponentData()
+{
+    // Create a Lua state with transforms bound like in the game.
+    lua_State* state = luaL_newstate();
+    luaL_openlibs(state);
+
+    Lua::getGlobalNamespace(state)
+        .beginClass<glm::vec2>("Vec2")
+            .addConstructor<void(*)(void)>()
+            .addData("x", &glm::vec2::x)
+            .addData("y", &glm::vec2::y)
+        .endClass()
+        .beginClass<TransformComponent>("TransformComponent")
+            .addFunction("SetPosition", &TransformComponent::SetPosition)
+            .addFunction("GetPosition", &TransformComponent::GetPositionCopy)
+        .endClass();
+
+    if(luaL_dostring(state, Script) != 0)
+    {
+        Log() << "Lua error - " << lua_tostring(state, -1) << ".";
+        lua_close(state);
+        return;
+    }
+
+    // Create transforms and pass them to scripts
+    // as bound objects and as pointers to their data.
+    std::vector<TransformComponent> transforms(EntityCount);
+
+    Lua::LuaRef objects = Lua::LuaRef::newTable(state);
+    Lua::LuaRef data = Lua::LuaRef::newTable(state);
+
+    data.push(state);
+
+    for(int i = 0; i < EntityCount; ++i)
+    {
+        objects[i + 1] = &transforms[i];
+
+        lua_pushlightuserdata(state, &transforms[i].GetData());
+        lua_rawseti(state, -2, i + 1);
+    }
+
+    lua_pop(state, 1);
+
+    Lua::LuaRef pointers = Lua::getGlobal(state, "CastData")(data);
+
+    const float timeDelta = 1.0f / 60.0f;
+
+    // Measure updates through bound methods, which copy positions.
+    double bindings = Benchmark::Measure(20, [&]()
+    {
+        CallScript(state, "UpdateBindings", objects, timeDelta);
+    });
+
+    // Measure updates through data pointers cast on every update.
+    double cast = Benchmark::Measure(20, [&]()
+    {
+        CallScript(state, "UpdateData", data, timeDelta);
+    });
+
+    // Measure updates through data pointers cast once.
+    double cached = Benchmark::Measure(20, [&]()
+    {
+        CallScript(state, "UpdateCastData", pointers, timeDelta);
+    });
+
+    Benchmark::Consume(transforms[0].GetPosition().x);
+
+    Benchmark::Report("ComponentData", "LuaBridge methods", bindings / EntityCount, "ns/entity");
+    Benchmark::Report("ComponentData", "FFI with cast", cast / EntityCount, "ns/entity");
+    Benchmark::Report("ComponentData", "FFI with cast pointers", cached / EntityCount, "ns/entity");
+
+    // Release references before closing the state.
+    objects = Lua::Nil();
+    data = Lua::Nil();
+    pointers = Lua::Nil();
+
+    lua_close(state);
+}
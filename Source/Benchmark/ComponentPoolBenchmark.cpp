@@ -0,0 +1,137 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Game/Component/Component.hpp"
+#include "Game/Component/ComponentPool.hpp"
+
+namespace
+{
+    // Component with a size typical for game components.
+    class BenchmarkComponent : public Component
+    {
+    public:
+        glm::vec2 position;
+        glm::vec2 scale;
+        float rotation;
+    };
+
+    // Component storage used before pools were sparse sets.
+    typedef std::unordered_map<EntityHandle, BenchmarkComponent> MapPool;
+
+    // Creates handles of entities in a random order.
+    std::vector<EntityHandle> CreateHandles(int count)
+    {
+        std::vector<EntityHandle> handles(count);
+
+        for(int i = 0; i < count; ++i)
+        {
+            handles[i].identifier = i + 1;
+            handles[i].version = 1;
+        }
+
+        std::shuffle(handles.begin(), handles.end(), std::mt19937(count));
+
+        return handles;
+    }
+
+    void MeasurePool(int count)
+    {
+        std::vector<EntityHandle> handles = CreateHandles(count);
+        std::string suffix = " (" + std::to_string(count) + ")";
+        int runs = std::max(1, 2000000 / count);
+
+        // Measure the sparse set pool.
+        {
+            ComponentPool<BenchmarkComponent> pool;
+
+            double create = Benchmark::Measure(runs, [&]()
+            {
+                pool.Clear();
+
+                for(const EntityHandle& handle : handles)
+                {
+                    pool.Create(handle)->rotation = 1.0f;
+                }
+            });
+
+            double lookup = Benchmark::Measure(runs, [&]()
+            {
+                float sum = 0.0f;
+
+                for(const EntityHandle& handle : handles)
+                {
+                    sum += pool.Lookup(handle)->rotation;
+                }
+
+                Benchmark::Consume(sum);
+            });
+
+            double iterate = Benchmark::Measure(runs, [&]()
+            {
+                float sum = 0.0f;
+
+                for(auto it = pool.Begin(); it != pool.End(); ++it)
+                {
+                    sum += it->second.rotation;
+                }
+
+                Benchmark::Consume(sum);
+            });
+
+            Benchmark::Report("ComponentPool", "Sparse set create" + suffix, create / count, "ns/op");
+            Benchmark::Report("ComponentPool", "Sparse set lookup" + suffix, lookup / count, "ns/op");
+            Benchmark::Report("ComponentPool", "Sparse set iterate" + suffix, iterate / count, "ns/op");
+        }
+
+        // Measure the hash map pool.
+        {
+            MapPool pool;
+
+            double create = Benchmark::Measure(runs, [&]()
+            {
+                pool.clear();
+
+                for(const EntityHandle& handle : handles)
+                {
+                    pool[handle].rotation = 1.0f;
+                }
+            });
+
+            double lookup = Benchmark::Measure(runs, [&]()
+            {
+                float sum = 0.0f;
+
+                for(const EntityHandle& handle : handles)
+                {
+                    sum += pool.find(handle)->second.rotation;
+                }
+
+                Benchmark::Consume(sum);
+            });
+
+            double iterate = Benchmark::Measure(runs, [&]()
+            {
+                float sum = 0.0f;
+
+                for(auto it = pool.begin(); it != pool.end(); ++it)
+                {
+                    sum += it->second.rotation;
+                }
+
+                Benchmark::Consume(sum);
+            });
+
+            Benchmark::Report("ComponentPool", "Hash map create" + suffix, create / count, "ns/op");
+            Benchmark::Report("ComponentPool", "Hash map lookup" + suffix, lookup / count, "ns/op");
+            Benchmark::Report("ComponentPool", "Hash map iterate" + suffix, iterate / count, "ns/op");
+        }
+    }
+}
+
+void BenchmarkComponentPool()
+{
+    // Compare pools at different entity counts.
+    MeasurePool(1000);
+    MeasurePool(10000);
+    MeasurePool(100000);
+}
@@ -0,0 +1,111 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Common/Delegate.hpp"
+
+namespace
+{
+    // Number of calls in a single run.
+    const int CallCount = 1000000;
+
+    // Receives calls and accumulates their values.
+    class Accumulator
+    {
+    public:
+        Accumulator() :
+            sum(0)
+        {
+        }
+
+        void Add(int value)
+        {
+            sum += value;
+        }
+
+        int sum;
+    };
+
+    // Same as above, but called through a virtual method.
+    class AccumulatorInterface
+    {
+    public:
+        virtual ~AccumulatorInterface()
+        {
+        }
+
+        virtual void Add(int value) = 0;
+    };
+
+    class VirtualAccumulator : public AccumulatorInterface
+    {
+    public:
+        VirtualAccumulator() :
+            sum(0)
+        {
+        }
+
+        void Add(int value)
+        {
+            sum += value;
+        }
+
+        int sum;
+    };
+
+    // Measures calls to a function object.
+    template<typename Function>
+    double MeasureCalls(Function& function)
+    {
+        return Benchmark::Measure(10, [&]()
+        {
+            for(int i = 0; i < CallCount; ++i)
+            {
+                function(i & 1);
+            }
+        }) / CallCount;
+    }
+}
+
+void BenchmarkDelegate()
+{
+    Accumulator accumulator;
+
+    // Measure a delegate bound to a method.
+    Delegate<void, int> delegate;
+    delegate.Bind<Accumulator, &Accumulator::Add>(&accumulator);
+
+    // Calls go through volatile pointers, so the compiler
+    // can't see what is bound and inline it into the loop.
+    Delegate<void, int>* volatile delegatePointer = &delegate;
+
+    auto invokeDelegate = [&delegatePointer](int value) { delegatePointer->Invoke(value); };
+    double delegateTime = MeasureCalls(invokeDelegate);
+
+    // Measure an unbound delegate that calls the empty stub.
+    Delegate<void, int> unbound;
+    Delegate<void, int>* volatile unboundPointer = &unbound;
+
+    auto invokeUnbound = [&unboundPointer](int value) { unboundPointer->Invoke(value); };
+    double unboundTime = MeasureCalls(invokeUnbound);
+
+    // Measure a standard function wrapping the same method.
+    std::function<void(int)> function = std::bind(&Accumulator::Add, &accumulator, std::placeholders::_1);
+    std::function<void(int)>* volatile functionPointer = &function;
+
+    auto invokeFunction = [&functionPointer](int value) { (*functionPointer)(value); };
+    double functionTime = MeasureCalls(invokeFunction);
+
+    // Measure a virtual method.
+    VirtualAccumulator virtualAccumulator;
+    AccumulatorInterface* volatile pointer = &virtualAccumulator;
+
+    auto invokeVirtual = [&pointer](int value) { pointer->Add(value); };
+    double virtualTime = MeasureCalls(invokeVirtual);
+
+    Benchmark::Consume(accumulator.sum + virtualAccumulator.sum);
+
+    Benchmark::Report("Delegate", "Delegate", delegateTime, "ns/call");
+    Benchmark::Report("Delegate", "Unbound delegate", unboundTime, "ns/call");
+    Benchmark::Report("Delegate", "std::function", functionTime, "ns/call");
+    Benchmark::Report("Delegate", "Virtual method", virtualTime, "ns/call");
+}
@@ -0,0 +1,120 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Common/Delegate.hpp"
+#include "Common/Dispatcher.hpp"
+#include "Common/Receiver.hpp"
+
+namespace
+{
+    // Number of events dispatched in a single run.
+    const int EventCount = 10000;
+
+    // Event with a size typical for game events.
+    struct BenchmarkEvent
+    {
+        int entity;
+        int value;
+    };
+
+    // Receives events and accumulates their values.
+    class Accumulator
+    {
+    public:
+        Accumulator() :
+            sum(0)
+        {
+        }
+
+        void OnEvent(const BenchmarkEvent& event)
+        {
+            sum += event.value;
+        }
+
+        int sum;
+    };
+
+    // Receivers chained through pointers, as dispatchers stored them before slot arrays.
+    struct LinkedReceiver
+    {
+        Delegate<void, const BenchmarkEvent&> delegate;
+        LinkedReceiver* next;
+    };
+
+    void MeasureDispatcher(int receiverCount)
+    {
+        std::string suffix = " (" + std::to_string(receiverCount) + " receivers)";
+        int runs = std::max(1, 1000 / receiverCount);
+
+        // Each receiver has its own instance, like receivers of different systems.
+        std::vector<Accumulator> accumulators(receiverCount);
+
+        // Measure the dispatcher.
+        {
+            std::unique_ptr<Receiver<BenchmarkEvent>[]> receivers(new Receiver<BenchmarkEvent>[receiverCount]);
+            Dispatcher<BenchmarkEvent> dispatcher;
+
+            for(int i = 0; i < receiverCount; ++i)
+            {
+                receivers[i].Bind<Accumulator, &Accumulator::OnEvent>(&accumulators[i]);
+                dispatcher.Subscribe(receivers[i]);
+            }
+
+            double time = Benchmark::Measure(runs, [&]()
+            {
+                for(int i = 0; i < EventCount; ++i)
+                {
+                    BenchmarkEvent event = { i, 1 };
+                    dispatcher.Dispatch(event);
+                }
+            });
+
+            Benchmark::Report("Dispatcher", "Slot array" + suffix, time / EventCount, "ns/event");
+        }
+
+        // Measure receivers linked in a list, scattered in memory between other allocations.
+        {
+            std::vector<std::unique_ptr<LinkedReceiver>> receivers;
+            std::vector<std::unique_ptr<char[]>> scattered;
+            LinkedReceiver* first = nullptr;
+
+            for(int i = 0; i < receiverCount; ++i)
+            {
+                receivers.emplace_back(new LinkedReceiver());
+                receivers.back()->delegate.Bind<Accumulator, &Accumulator::OnEvent>(&accumulators[i]);
+                receivers.back()->next = first;
+                first = receivers.back().get();
+
+                scattered.emplace_back(new char[256]);
+            }
+
+            double time = Benchmark::Measure(runs, [&]()
+            {
+                for(int i = 0; i < EventCount; ++i)
+                {
+                    BenchmarkEvent event = { i, 1 };
+
+                    for(LinkedReceiver* receiver = first; receiver != nullptr; receiver = receiver->next)
+                    {
+                        receiver->delegate.Invoke(event);
+                    }
+                }
+            });
+
+            Benchmark::Report("Dispatcher", "Linked list" + suffix, time / EventCount, "ns/event");
+        }
+
+        for(const Accumulator& accumulator : accumulators)
+        {
+            Benchmark::Consume(accumulator.sum);
+        }
+    }
+}
+
+void BenchmarkDispatcher()
+{
+    // Compare dispatching to different numbers of receivers.
+    MeasureDispatcher(1);
+    MeasureDispatcher(10);
+    MeasureDispatcher(1000);
+}
@@ -0,0 +1,81 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Common/Services.hpp"
+#include "Game/Event/EventSystem.hpp"
+#include "Game/Entity/EntitySystem.hpp"
+
+namespace
+{
+    // Number of validated handles.
+    const int HandleCount = 100000;
+
+    void MeasureValidation(const EntitySystem& entitySystem, const EntitySystem::EntityList& handles, const std::string& order)
+    {
+        // Measure checking handles one by one.
+        double single = Benchmark::Measure(100, [&]()
+        {
+            int valid = 0;
+
+            for(const EntityHandle& handle : handles)
+            {
+                valid += entitySystem.IsHandleValid(handle);
+            }
+
+            Benchmark::Consume(valid);
+        });
+
+        // Measure checking all handles at once.
+        EntitySystem::ValidityMask mask;
+
+        double batched = Benchmark::Measure(100, [&]()
+        {
+            entitySystem.ValidateHandles(handles.data(), (int)handles.size(), mask);
+
+            Benchmark::Consume(mask[0]);
+        });
+
+        Benchmark::Report("EntitySystem", "IsHandleValid (" + order + ")", single / handles.size(), "ns/handle");
+        Benchmark::Report("EntitySystem", "ValidateHandles (" + order + ")", batched / handles.size(), "ns/handle");
+    }
+}
+
+void BenchmarkEntitySystem()
+{
+    // Create entity systems.
+    EventSystem eventSystem;
+    eventSystem.Initialize();
+
+    Services services;
+    services.Set(&eventSystem);
+
+    EntitySystem entitySystem;
+    entitySystem.Initialize(services);
+
+    // Create entities and destroy every fourth of them,
+    // so some handles are stale and some slots are reused.
+    EntitySystem::EntityList handles;
+    entitySystem.CreateEntities(HandleCount, handles);
+    entitySystem.ProcessCommands();
+
+    for(int i = 0; i < HandleCount; i += 4)
+    {
+        entitySystem.DestroyEntity(handles[i]);
+    }
+
+    entitySystem.ProcessCommands();
+
+    EntitySystem::EntityList created;
+    entitySystem.CreateEntities(HandleCount / 8, created);
+    entitySystem.ProcessCommands();
+
+    handles.insert(handles.end(), created.begin(), created.end());
+    handles.resize(HandleCount);
+
+    // Validate handles in the order of creation and in a random order.
+    MeasureValidation(entitySystem, handles, "sequential");
+
+    std::shuffle(handles.begin(), handles.end(), std::mt19937(HandleCount));
+
+    MeasureValidation(entitySystem, handles, "random");
+}
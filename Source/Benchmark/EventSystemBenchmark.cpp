@@ -0,0 +1,109 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Game/Event/EventSystem.hpp"
+
+namespace
+{
+    // Number of events sent in a single run.
+    const int EventCount = 10000;
+
+    // Event with a size typical for game events.
+    struct BenchmarkEvent
+    {
+        int entity;
+        int value;
+    };
+
+    // Receives events and accumulates their values.
+    class Accumulator
+    {
+    public:
+        Accumulator() :
+            sum(0)
+        {
+        }
+
+        void OnEvent(const BenchmarkEvent& event)
+        {
+            sum += event.value;
+        }
+
+        int sum;
+    };
+
+    void MeasureEventSystem(int receiverCount)
+    {
+        std::string suffix = " (" + std::to_string(receiverCount) + " receivers)";
+        int runs = std::max(1, 1000 / receiverCount);
+
+        // Create an event system with subscribed receivers.
+        EventSystem eventSystem;
+        eventSystem.Initialize();
+
+        std::vector<Accumulator> accumulators(receiverCount);
+        std::unique_ptr<Receiver<BenchmarkEvent>[]> receivers(new Receiver<BenchmarkEvent>[receiverCount]);
+
+        for(int i = 0; i < receiverCount; ++i)
+        {
+            receivers[i].Bind<Accumulator, &Accumulator::OnEvent>(&accumulators[i]);
+            eventSystem.Subscribe(receivers[i]);
+        }
+
+        // Measure dispatching events immediately.
+        double dispatch = Benchmark::Measure(runs, [&]()
+        {
+            for(int i = 0; i < EventCount; ++i)
+            {
+                BenchmarkEvent event = { i, 1 };
+                eventSystem.Dispatch(event);
+            }
+        });
+
+        // Measure queuing events and flushing them.
+        double queue = Benchmark::Measure(runs, [&]()
+        {
+            for(int i = 0; i < EventCount; ++i)
+            {
+                BenchmarkEvent event = { i, 1 };
+                eventSystem.Queue(event);
+            }
+
+            eventSystem.Flush();
+        });
+
+        // Measure queuing events from another thread and flushing them.
+        double threaded = Benchmark::Measure(runs, [&]()
+        {
+            std::thread thread([&]()
+            {
+                for(int i = 0; i < EventCount; ++i)
+                {
+                    BenchmarkEvent event = { i, 1 };
+                    eventSystem.Queue(event);
+                }
+            });
+
+            thread.join();
+
+            eventSystem.Flush();
+        });
+
+        for(const Accumulator& accumulator : accumulators)
+        {
+            Benchmark::Consume(accumulator.sum);
+        }
+
+        Benchmark::Report("EventSystem", "Dispatch" + suffix, dispatch / EventCount, "ns/event");
+        Benchmark::Report("EventSystem", "Queue and flush" + suffix, queue / EventCount, "ns/event");
+        Benchmark::Report("EventSystem", "Queue from thread and flush" + suffix, threaded / EventCount, "ns/event");
+    }
+}
+
+void BenchmarkEventSystem()
+{
+    // Compare sending events to different numbers of receivers.
+    MeasureEventSystem(1);
+    MeasureEventSystem(10);
+    MeasureEventSystem(1000);
+}
@@ -0,0 +1,98 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Common/JobSystem.hpp"
+
+namespace
+{
+    // Number of elements processed by the parallel loop.
+    const int ElementCount = 1 << 20;
+
+    // Number of elements in a single job.
+    const int BatchSize = 4096;
+
+    // Work with a cost similar to updating a simple component.
+    void Process(std::vector<float>& values, int begin, int end)
+    {
+        for(int i = begin; i < end; ++i)
+        {
+            values[i] = std::sqrt(values[i] * values[i] + 1.0f) * 0.5f;
+        }
+    }
+
+    double MeasureParallelFor(int workerCount, std::vector<float>& values)
+    {
+        JobSystem jobSystem;
+        jobSystem.Initialize(workerCount);
+
+        // Measure the time of processing the whole range.
+        double time = Benchmark::Measure(50, [&]()
+        {
+            jobSystem.ParallelFor(0, ElementCount, BatchSize, [&values](int begin, int end)
+            {
+                Process(values, begin, end);
+            });
+        });
+
+        Benchmark::Consume(values[0]);
+
+        return time;
+    }
+
+    double MeasureSubmit(int workerCount)
+    {
+        JobSystem jobSystem;
+        jobSystem.Initialize(workerCount);
+
+        // Measure the overhead of submitting and waiting for empty jobs.
+        const int JobCount = 10000;
+
+        double time = Benchmark::Measure(20, [&]()
+        {
+            JobCounter counter(0);
+
+            for(int i = 0; i < JobCount; ++i)
+            {
+                jobSystem.Submit([]() {}, &counter);
+            }
+
+            jobSystem.Wait(counter);
+        });
+
+        return time / JobCount;
+    }
+}
+
+void BenchmarkJobSystem()
+{
+    std::vector<float> values(ElementCount, 1.0f);
+
+    // Scale from running on the calling thread only to all hardware threads.
+    int maximumWorkers = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    std::vector<int> workerCounts(1, 0);
+
+    for(int workers = 1; workers < maximumWorkers; workers *= 2)
+    {
+        workerCounts.push_back(workers);
+    }
+
+    workerCounts.push_back(maximumWorkers);
+
+    double serial = 0.0;
+
+    for(int workers : workerCounts)
+    {
+        std::string suffix = " (" + std::to_string(workers) + " workers)";
+
+        double time = MeasureParallelFor(workers, values);
+
+        if(workers == 0)
+        {
+            serial = time;
+        }
+
+        Benchmark::Report("JobSystem", "ParallelFor" + suffix, time / 1000000.0, "ms/run");
+        Benchmark::Report("JobSystem", "ParallelFor speedup" + suffix, serial / time, "x");
+        Benchmark::Report("JobSystem", "Submit and wait" + suffix, MeasureSubmit(workers), "ns/job");
+    }
+}
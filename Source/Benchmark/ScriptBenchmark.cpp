@@ -0,0 +1,108 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Game/Entity/EntityHandle.hpp"
+#include "Game/Script/ScriptComponent.hpp"
+
+namespace
+{
+    // Number of scripted entities.
+    const int EntityCount = 10000;
+
+    // Scripts with and without an update function, like in the game.
+    const char* Scripts =
+        "Moving = {} Moving.__index = Moving "
+        "function Moving:OnUpdate(entity, timeDelta) self.x = self.x + self.speed * timeDelta end "
+        "Idle = {} Idle.__index = Idle "
+        "function Idle:OnDamaged(entity, value, alive) end ";
+
+    // Calls a script function found by its name, as script components did before caching callbacks.
+    template<typename... Arguments>
+    void CallByName(const Lua::LuaRef& script, std::string name, Arguments... arguments)
+    {
+        Lua::LuaRef function = script[name];
+
+        if(function.isFunction())
+        {
+            try
+            {
+                function(script, arguments...);
+            }
+            catch(Lua::LuaException& exception)
+            {
+                Log() << "Lua error - " << exception.what() << ".";
+            }
+        }
+    }
+}
+
+void BenchmarkScript()
+{
+    // Create a Lua state with entity handles bound like in the game.
+    lua_State* state = luaL_newstate();
+    luaL_openlibs(state);
+
+    Lua::getGlobalNamespace(state)
+        .beginClass<EntityHandle>("EntityHandle")
+        .endClass();
+
+    luaL_dostring(state, Scripts);
+
+    // Create components with a moving script for every second entity,
+    // while other entities only have scripts without an update function.
+    Lua::LuaRef moving = Lua::getGlobal(state, "Moving");
+    Lua::LuaRef idle = Lua::getGlobal(state, "Idle");
+
+    std::vector<ScriptComponent> components(EntityCount);
+    std::vector<EntityHandle> entities(EntityCount);
+
+    for(int i = 0; i < EntityCount; ++i)
+    {
+        Lua::LuaRef instance = Lua::LuaRef::newTable(state);
+        instance["x"] = 0.0f;
+        instance["speed"] = 1.0f;
+        instance.push(state);
+        (i % 2 == 0 ? moving : idle).push(state);
+        lua_setmetatable(state, -2);
+        lua_pop(state, 1);
+
+        components[i].AddScript(instance);
+
+        entities[i].identifier = i + 1;
+    }
+
+    const float timeDelta = 1.0f / 60.0f;
+
+    // Measure looking up callbacks by name on every call.
+    double lookup = Benchmark::Measure(20, [&]()
+    {
+        for(int i = 0; i < EntityCount; ++i)
+        {
+            for(const ScriptComponent::Script& script : components[i].GetScripts())
+            {
+                CallByName(script.instance, "OnUpdate", entities[i], timeDelta);
+            }
+        }
+    });
+
+    // Measure calling callbacks cached when scripts were added.
+    double cached = Benchmark::Measure(20, [&]()
+    {
+        for(int i = 0; i < EntityCount; ++i)
+        {
+            components[i].Call(ScriptCallbacks::OnUpdate, entities[i], timeDelta);
+        }
+    });
+
+    Benchmark::Consume(components[0].GetScripts()[0].instance["x"].cast<float>());
+
+    Benchmark::Report("Script", "OnUpdate by name", lookup / EntityCount, "ns/entity");
+    Benchmark::Report("Script", "OnUpdate cached", cached / EntityCount, "ns/entity");
+
+    // Release references before closing the state.
+    components.clear();
+    moving = Lua::Nil();
+    idle = Lua::Nil();
+
+    lua_close(state);
+}
@@ -0,0 +1,118 @@
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+#include "Game/Collision/SweepAndPrune.hpp"
+#include "Game/Collision/CollisionComponent.hpp"
+
+namespace
+{
+    // Average area of the world per object, so density stays the same at every count.
+    const float AreaPerObject = 40.0f * 40.0f;
+
+    // Objects with random boxes and collision bits, scattered over the world.
+    struct Scene
+    {
+        std::vector<CollisionComponent> collisions;
+        CollisionBroadPhase::ObjectList objects;
+    };
+
+    void CreateScene(Scene& scene, int count)
+    {
+        std::mt19937 random(count);
+
+        float worldSize = std::sqrt(AreaPerObject * count);
+        std::uniform_real_distribution<float> position(0.0f, worldSize);
+        std::uniform_real_distribution<float> size(8.0f, 24.0f);
+        std::uniform_int_distribution<int> bits(1, 15);
+
+        scene.collisions.resize(count);
+        scene.objects.resize(count);
+
+        for(int i = 0; i < count; ++i)
+        {
+            CollisionComponent& collision = scene.collisions[i];
+            collision.SetType(bits(random));
+            collision.SetMask(bits(random));
+
+            glm::vec2 minimum(position(random), position(random));
+            glm::vec2 maximum = minimum + glm::vec2(size(random), size(random));
+
+            CollisionObject& object = scene.objects[i];
+            object.collision = &collision;
+            object.worldAABB = glm::vec4(minimum, maximum);
+            object.sweptAABB = object.worldAABB;
+            object.enabled = true;
+        }
+    }
+
+    // Tests every pair of objects, which the sweep replaced.
+    void FindPairsBruteForce(const CollisionBroadPhase::ObjectList& objects, CollisionBroadPhase::PairList& pairs)
+    {
+        for(int a = 0; a < (int)objects.size(); ++a)
+        {
+            for(int b = a + 1; b < (int)objects.size(); ++b)
+            {
+                const CollisionObject& first = objects[a];
+                const CollisionObject& second = objects[b];
+
+                bool masked = (first.collision->GetMask() & second.collision->GetType()) || (second.collision->GetMask() & first.collision->GetType());
+
+                if(!masked)
+                    continue;
+
+                const glm::vec4& boxA = first.sweptAABB;
+                const glm::vec4& boxB = second.sweptAABB;
+
+                if(boxA.x > boxB.z || boxA.z < boxB.x || boxA.y > boxB.w || boxA.w < boxB.y)
+                    continue;
+
+                pairs.push_back(CollisionBroadPhase::ObjectPair(a, b));
+            }
+        }
+    }
+
+    void MeasureBroadPhase(int count)
+    {
+        Scene scene;
+        CreateScene(scene, count);
+
+        std::string suffix = " (" + std::to_string(count) + ")";
+        CollisionBroadPhase::PairList pairs;
+
+        // Measure the sweep.
+        SweepAndPrune sweepAndPrune;
+
+        double sweep = Benchmark::Measure(std::max(1, 2000000 / count), [&]()
+        {
+            pairs.clear();
+            sweepAndPrune.FindPairs(scene.objects, pairs, nullptr);
+        });
+
+        double pairCount = (double)pairs.size();
+
+        // Measure testing every pair with fewer runs, as it grows quadratically.
+        double bruteForce = Benchmark::Measure(std::max(1, 20000000 / (count * count)), [&]()
+        {
+            pairs.clear();
+            FindPairsBruteForce(scene.objects, pairs);
+        });
+
+        assert((double)pairs.size() == pairCount);
+
+        Benchmark::Report("SweepAndPrune", "Pairs found" + suffix, pairCount, "pairs");
+        Benchmark::Report("SweepAndPrune", "Sweep and prune" + suffix, sweep / 1000.0, "us/run");
+        Benchmark::Report("SweepAndPrune", "Sweep and prune throughput" + suffix, pairCount / sweep * 1000.0, "Mpairs/s");
+        Benchmark::Report("SweepAndPrune", "Brute force" + suffix, bruteForce / 1000.0, "us/run");
+        Benchmark::Report("SweepAndPrune", "Brute force throughput" + suffix, pairCount / bruteForce * 1000.0, "Mpairs/s");
+    }
+}
+
+void BenchmarkSweepAndPrune()
+{
+    // Scale from a few objects to far more than a typical scene.
+    MeasureBroadPhase(100);
+    MeasureBroadPhase(1000);
+    MeasureBroadPhase(5000);
+    MeasureBroadPhase(10000);
+    MeasureBroadPhase(20000);
+}
@@ -19,6 +19,12 @@
 //      delegate.Bind<Class, &Class::Function>(&instance);
 //      delegate.Invoke("hello", 5);
 //
+//  Functions and methods are bound as template arguments, so each stub
+//  calls them directly and they can be inlined into it. Invoking costs
+//  a single indirect call to the stub. Unbound delegates point at an
+//  empty stub instead of null, so invoking never has to branch. Stub
+//  addresses aren't compared, as identical stubs may be folded into one.
+//
 
 template<typename ReturnType, typename... Arguments>
 class Delegate
@@ -27,6 +33,11 @@ private:
     typedef void* InstancePtr;
     typedef ReturnType (*FunctionPtr)(InstancePtr, Arguments...);
 
+    static ReturnType EmptyStub(InstancePtr, Arguments...)
+    {
+        return ReturnType();
+    }
+
     template<ReturnType (*Function)(Arguments...)>
     static ReturnType FunctionStub(InstancePtr instance, Arguments... arguments)
     {
@@ -42,7 +53,7 @@ private:
 public:
     Delegate() :
         m_instance(nullptr),
-        m_function(nullptr)
+        m_function(&EmptyStub)
     {
     }
 
@@ -60,11 +71,14 @@ public:
         m_function = &MethodStub<InstanceType, Function>;
     }
 
-    ReturnType Invoke(Arguments... arguments)
+    void Unbind()
     {
-        if(m_function == nullptr)
-            return;
+        m_instance = nullptr;
+        m_function = &EmptyStub;
+    }
 
+    ReturnType Invoke(Arguments... arguments) const
+    {
         return m_function(m_instance, std::forward<Arguments>(arguments)...);
     }
 
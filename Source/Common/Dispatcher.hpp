@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Precompiled.hpp"
+#include "Delegate.hpp"
 #include "Receiver.hpp"
 
 // Forward declarations.
@@ -22,7 +23,7 @@ protected:
     }
 
 public:
-    ~DispatcherInterface()
+    virtual ~DispatcherInterface()
     {
     }
 };
@@ -34,6 +35,15 @@ public:
 //  receiver's destruction. No dangling pointers are left.
 //  A single dispatcher instance can have multiple receivers subscribed.
 //
+//  Receivers are kept in a contiguous array of slots holding copies of
+//  their delegates, so dispatching doesn't chase pointers. Each receiver
+//  knows its slot, so subscribing and unsubscribing take constant time.
+//  Unsubscribed slots are left empty and compacted later, preserving the
+//  order of receivers. Receivers can safely unsubscribe during dispatch,
+//  while receivers subscribed during dispatch only get later events.
+//  Empty slots hold unbound delegates, so dispatch invokes every slot
+//  without checking it first.
+//
 //  Example usage:
 //      struct EventData { /* ... */ };
 //      
@@ -56,6 +66,26 @@ public:
 template<typename Type>
 class Dispatcher : public DispatcherInterface
 {
+public:
+    friend Receiver<Type>;
+
+    // Type declarations.
+    typedef Delegate<void, const Type&> ReceiverDelegate;
+
+    struct ReceiverSlot
+    {
+        ReceiverDelegate delegate;
+        Receiver<Type>* receiver;
+    };
+
+    typedef std::vector<ReceiverSlot> ReceiverSlotList;
+
+    // Special values.
+    enum
+    {
+        InvalidSlot = -1,
+    };
+
 public:
     Dispatcher();
     ~Dispatcher();
@@ -73,11 +103,18 @@ public:
     bool HasSubscribers() const;
 
 private:
-    Receiver<Type>* Previous(Receiver<Type>& receiver);
+    void Rebind(Receiver<Type>& receiver);
+    void Compact();
 
 private:
-    Receiver<Type>* m_begin;
-    Receiver<Type>* m_end;
+    // Slots of subscribed receivers.
+    ReceiverSlotList m_slots;
+
+    // Number of subscribed receivers.
+    int m_count;
+
+    // Depth of nested dispatch calls.
+    int m_dispatching;
 };
 
 #include "Dispatcher.inl"
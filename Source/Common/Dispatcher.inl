@@ -2,8 +2,8 @@
 
 template<typename Type>
 Dispatcher<Type>::Dispatcher() :
-    m_begin(nullptr),
-    m_end(nullptr)
+    m_count(0),
+    m_dispatching(0)
 {
 }
 
@@ -17,22 +17,19 @@ template<typename Type>
 void Dispatcher<Type>::Cleanup()
 {
     // Unsubscribe all receivers.
-    Receiver<Type>* iterator = m_begin;
-    
-    while(iterator != nullptr)
+    for(ReceiverSlot& slot : m_slots)
     {
-        Receiver<Type>* receiver = iterator;
-
-        // Advance to the next receiver.
-        iterator = iterator->m_next;
+        if(slot.receiver == nullptr)
+            continue;
 
         // Unsubscribe a receiver.
-        receiver->m_subject = nullptr;
-        receiver->m_next = nullptr;
+        slot.receiver->m_subject = nullptr;
+        slot.receiver->m_slot = InvalidSlot;
     }
-    
-    m_begin = nullptr;
-    m_end = nullptr;
+
+    ClearContainer(m_slots);
+
+    m_count = 0;
 }
 
 template<typename Type>
@@ -48,24 +45,19 @@ void Dispatcher<Type>::Subscribe(Receiver<Type>& receiver)
     if(receiver.m_subject != nullptr)
         return;
 
-    assert(receiver.m_next == nullptr);
-    
-    // Add receiver to the linked list.
-    if(m_begin == nullptr)
-    {
-        assert(m_end == nullptr);
-        m_begin = &receiver;
-        m_end = &receiver;
-    }
-    else
-    {
-        assert(m_end != nullptr);
-        m_end->m_next = &receiver;
-        m_end = &receiver;
-    }
+    assert(receiver.m_slot == InvalidSlot);
+
+    // Add receiver at the end of the slot list.
+    ReceiverSlot slot;
+    slot.delegate = receiver;
+    slot.receiver = &receiver;
+
+    m_slots.push_back(slot);
+    m_count += 1;
 
     // Set dispatcher as receiver's subject.
     receiver.m_subject = this;
+    receiver.m_slot = (int)m_slots.size() - 1;
 }
 
 template<typename Type>
@@ -81,79 +73,83 @@ void Dispatcher<Type>::Unsubscribe(Receiver<Type>& receiver)
     if(receiver.m_subject != this)
         return;
 
-    // Remove receiver from the linked list.
-    if(m_begin == &receiver)
-    {
-        if(m_end == &receiver)
-        {
-            m_begin = nullptr;
-            m_end = nullptr;
-        }
-        else
-        {
-            m_begin = receiver.m_next; 
-        }
-    }
-    else
-    {
-        Receiver<Type>* previous = Previous(receiver);
-        assert(previous != nullptr);
+    assert(m_slots[receiver.m_slot].receiver == &receiver);
 
-        previous->m_next = receiver.m_next;
+    // Leave an empty slot in place of the receiver.
+    ReceiverSlot& slot = m_slots[receiver.m_slot];
+    slot.delegate.Unbind();
+    slot.receiver = nullptr;
 
-        if(m_end == &receiver)
-        {
-            m_end = previous;
-        }
-    }
+    m_count -= 1;
 
     // Remove dispatcher as receiver's subject.
     receiver.m_subject = nullptr;
-    receiver.m_next = nullptr;
+    receiver.m_slot = InvalidSlot;
+
+    // Remove empty slots once they outnumber receivers.
+    if(m_dispatching == 0 && (int)m_slots.size() > 2 * m_count)
+    {
+        Compact();
+    }
 }
 
 template<typename Type>
 void Dispatcher<Type>::Dispatch(const Type& event)
 {
+    // Receivers subscribed during dispatch are added past this count.
+    int slotCount = (int)m_slots.size();
+
+    m_dispatching += 1;
+
     // Send an event to all receivers.
-    Receiver<Type>* iterator = m_begin;
-        
-    while(iterator != nullptr)
+    // Slots are accessed by index, as the list can grow while dispatching.
+    for(int i = 0; i < slotCount; ++i)
     {
-        // Send an event to a receiver.
-        iterator->Receive(event);
+        m_slots[i].delegate.Invoke(event);
+    }
 
-        // Advance to the next receiver.
-        iterator = iterator->m_next;
+    m_dispatching -= 1;
+
+    // Remove empty slots left by receivers unsubscribed during dispatch.
+    if(m_dispatching == 0 && (int)m_slots.size() > 2 * m_count)
+    {
+        Compact();
     }
 }
 
 template<typename Type>
-Receiver<Type>* Dispatcher<Type>::Previous(Receiver<Type>& receiver)
+void Dispatcher<Type>::Rebind(Receiver<Type>& receiver)
 {
-    // Iterate through all receivers.
-    Receiver<Type>* iterator = m_begin;
-    Receiver<Type>* previous = nullptr;
+    assert(receiver.m_subject == this);
 
-    while(iterator != nullptr)
-    {
-        // Check if it's the one we are looking for.
-        if(iterator == &receiver)
-            break;
+    // Update the delegate copy of a receiver bound again.
+    m_slots[receiver.m_slot].delegate = receiver;
+}
+
+template<typename Type>
+void Dispatcher<Type>::Compact()
+{
+    assert(m_dispatching == 0);
 
-        // Save the previous iterator.
-        previous = iterator;
+    // Move receivers over empty slots while preserving their order.
+    int count = 0;
 
-        // Iterate to the next receiver.
-        iterator = iterator->m_next;
+    for(ReceiverSlot& slot : m_slots)
+    {
+        if(slot.receiver == nullptr)
+            continue;
+
+        slot.receiver->m_slot = count;
+        m_slots[count++] = slot;
     }
 
-    // Return the previous receiver.
-    return previous;
+    assert(count == m_count);
+
+    m_slots.resize(count);
 }
 
 template<typename Type>
 bool Dispatcher<Type>::HasSubscribers() const
 {
-    return m_begin != nullptr;
+    return m_count != 0;
 }
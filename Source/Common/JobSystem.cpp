@@ -0,0 +1,276 @@
+#include "Precompiled.hpp"
+#include "JobSystem.hpp"
+
+JobSystem::JobSystem() :
+    m_nextQueue(0),
+    m_pendingCount(0),
+    m_quitting(false),
+    m_initialized(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    Cleanup();
+}
+
+bool JobSystem::Initialize(int workerCount)
+{
+    Cleanup();
+
+    // Setup scope guard.
+    SCOPE_GUARD_IF(!m_initialized, Cleanup());
+
+    // Determine the number of workers.
+    if(workerCount < 0)
+    {
+        workerCount = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+    }
+
+    // Create job queues before any worker starts.
+    for(int i = 0; i < workerCount; ++i)
+    {
+        m_queues.emplace_back(new JobQueue());
+    }
+
+    // Start worker threads.
+    for(int i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&JobSystem::WorkerMain, this, i);
+        m_workerIds.push_back(m_workers.back().get_id());
+    }
+
+    // Success!
+    return m_initialized = true;
+}
+
+void JobSystem::Cleanup()
+{
+    // Signal worker threads to quit.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quitting = true;
+    }
+
+    m_sleepCondition.notify_all();
+
+    // Wait for worker threads to finish.
+    for(std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    ClearContainer(m_workers);
+    ClearContainer(m_workerIds);
+    ClearContainer(m_queues);
+
+    m_nextQueue = 0;
+    m_pendingCount = 0;
+
+    m_quitting = false;
+    m_initialized = false;
+}
+
+void JobSystem::Submit(Job job, JobCounter* counter)
+{
+    assert(m_initialized);
+
+    // Create a job entry.
+    JobEntry entry;
+    entry.job = std::move(job);
+    entry.counter = counter;
+
+    if(entry.counter != nullptr)
+    {
+        *entry.counter += 1;
+    }
+
+    // Run the job in place if there are no workers.
+    if(m_workers.empty())
+    {
+        Execute(entry);
+        return;
+    }
+
+    // Add job to the queue of the current worker or distribute
+    // jobs submitted from other threads between all workers.
+    int index = GetWorkerIndex();
+
+    if(index < 0)
+    {
+        index = m_nextQueue++ % m_queues.size();
+    }
+
+    {
+        JobQueue& queue = *m_queues[index];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.entries.push_back(std::move(entry));
+    }
+
+    m_pendingCount += 1;
+
+    // Wake up a sleeping worker.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+
+    m_sleepCondition.notify_one();
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    assert(m_initialized);
+
+    // Help with pending jobs until all counted jobs finish.
+    while(counter > 0)
+    {
+        if(!RunJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::RunJob()
+{
+    assert(m_initialized);
+
+    if(m_workers.empty())
+        return false;
+
+    // Take a job, starting from own queue if called by a worker.
+    JobEntry entry;
+
+    if(!PopJob(GetWorkerIndex(), entry))
+        return false;
+
+    // Run the job.
+    Execute(entry);
+
+    return true;
+}
+
+void JobSystem::ParallelFor(int begin, int end, int batchSize, const RangeJob& function)
+{
+    assert(m_initialized);
+    assert(batchSize > 0);
+
+    if(begin >= end)
+        return;
+
+    // Process the range in place if there are no workers.
+    if(m_workers.empty() || end - begin <= batchSize)
+    {
+        function(begin, end);
+        return;
+    }
+
+    // Submit a job for each batch.
+    JobCounter counter(0);
+
+    for(int batchBegin = begin; batchBegin < end; batchBegin += batchSize)
+    {
+        int batchEnd = std::min(batchBegin + batchSize, end);
+
+        Submit([&function, batchBegin, batchEnd]()
+        {
+            function(batchBegin, batchEnd);
+        }, &counter);
+    }
+
+    // Wait for all batches to finish.
+    Wait(counter);
+}
+
+int JobSystem::GetWorkerCount() const
+{
+    return (int)m_workers.size();
+}
+
+void JobSystem::WorkerMain(int index)
+{
+    while(true)
+    {
+        // Run jobs while there are any.
+        JobEntry entry;
+
+        if(PopJob(index, entry))
+        {
+            Execute(entry);
+            continue;
+        }
+
+        // Wait for a job or a quit signal.
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+        m_sleepCondition.wait(lock, [this]()
+        {
+            return m_quitting || m_pendingCount > 0;
+        });
+
+        if(m_quitting && m_pendingCount == 0)
+            return;
+    }
+}
+
+int JobSystem::GetWorkerIndex() const
+{
+    // Find the worker that matches the calling thread.
+    std::thread::id id = std::this_thread::get_id();
+
+    for(unsigned int i = 0; i < m_workerIds.size(); ++i)
+    {
+        if(m_workerIds[i] == id)
+            return i;
+    }
+
+    return -1;
+}
+
+bool JobSystem::PopJob(int index, JobEntry& entry)
+{
+    int queueCount = (int)m_queues.size();
+    int firstQueue = std::max(0, index);
+
+    for(int i = 0; i < queueCount; ++i)
+    {
+        JobQueue& queue = *m_queues[(firstQueue + i) % queueCount];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if(queue.entries.empty())
+            continue;
+
+        // Take the newest job from own queue while it's still hot in cache,
+        // but steal the oldest job from other queues to take larger chunks of work.
+        if(i == 0 && index >= 0)
+        {
+            entry = std::move(queue.entries.back());
+            queue.entries.pop_back();
+        }
+        else
+        {
+            entry = std::move(queue.entries.front());
+            queue.entries.pop_front();
+        }
+
+        m_pendingCount -= 1;
+
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::Execute(JobEntry& entry)
+{
+    // Run the job.
+    entry.job();
+
+    // Signal the job completion.
+    if(entry.counter != nullptr)
+    {
+        *entry.counter -= 1;
+    }
+}
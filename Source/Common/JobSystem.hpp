@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+//
+// Job System
+//  Runs jobs on a pool of worker threads. Each worker has its own
+//  queue of jobs and steals jobs from other workers when it runs out.
+//  Threads waiting for jobs to complete help by running pending jobs.
+//
+//  Submitting a job:
+//      JobSystem jobSystem;
+//      jobSystem.Initialize();
+//      jobSystem.Submit([]()
+//      {
+//          /* ... */
+//      });
+//
+//  Waiting for jobs:
+//      JobCounter counter(0);
+//      jobSystem.Submit(firstJob, &counter);
+//      jobSystem.Submit(secondJob, &counter);
+//      jobSystem.Wait(counter);
+//
+//  Processing a range in parallel:
+//      jobSystem.ParallelFor(0, count, 64, [&](int begin, int end)
+//      {
+//          for(int i = begin; i < end; ++i)
+//          {
+//              /* ... */
+//          }
+//      });
+//
+
+// Counter of unfinished jobs.
+typedef std::atomic<int> JobCounter;
+
+class JobSystem
+{
+public:
+    // Type declarations.
+    typedef std::function<void()> Job;
+    typedef std::function<void(int, int)> RangeJob;
+
+    struct JobEntry
+    {
+        JobEntry() :
+            counter(nullptr)
+        {
+        }
+
+        Job job;
+        JobCounter* counter;
+    };
+
+    struct JobQueue
+    {
+        std::deque<JobEntry> entries;
+        std::mutex mutex;
+    };
+
+    typedef std::vector<std::unique_ptr<JobQueue>> JobQueueList;
+    typedef std::vector<std::thread> WorkerList;
+    typedef std::vector<std::thread::id> WorkerIdList;
+
+public:
+    JobSystem();
+    ~JobSystem();
+
+    // Starts worker threads. Uses one less than available hardware threads by default.
+    bool Initialize(int workerCount = -1);
+
+    // Stops worker threads after finishing all submitted jobs.
+    void Cleanup();
+
+    // Submits a job to be run on a worker thread.
+    // Counter is incremented now and decremented after the job finishes.
+    void Submit(Job job, JobCounter* counter = nullptr);
+
+    // Runs pending jobs on the calling thread until the counter reaches zero.
+    void Wait(const JobCounter& counter);
+
+    // Runs a single pending job on the calling thread.
+    // Returns false if there were no jobs to run.
+    bool RunJob();
+
+    // Splits a range into batches and processes them in parallel.
+    // Returns after the whole range has been processed.
+    void ParallelFor(int begin, int end, int batchSize, const RangeJob& function);
+
+    // Returns the number of worker threads.
+    int GetWorkerCount() const;
+
+private:
+    void WorkerMain(int index);
+    int GetWorkerIndex() const;
+    bool PopJob(int index, JobEntry& entry);
+    void Execute(JobEntry& entry);
+
+private:
+    // Worker threads.
+    WorkerList m_workers;
+    WorkerIdList m_workerIds;
+
+    // Job queues of each worker.
+    JobQueueList m_queues;
+
+    // Queue used for jobs submitted from outside of workers.
+    std::atomic<unsigned int> m_nextQueue;
+
+    // Number of jobs waiting in queues.
+    std::atomic<int> m_pendingCount;
+
+    // Sleep synchronization.
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+
+    // System state.
+    std::atomic<bool> m_quitting;
+    bool m_initialized;
+};
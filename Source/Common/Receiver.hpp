@@ -24,10 +24,13 @@ class Receiver : public Delegate<void, const Type&>
 public:
     friend Dispatcher<Type>;
 
+    // Type declarations.
+    typedef Delegate<void, const Type&> BaseDelegate;
+
 public:
     Receiver() :
         m_subject(nullptr),
-        m_next(nullptr)
+        m_slot(Dispatcher<Type>::InvalidSlot)
     {
     }
 
@@ -42,20 +45,37 @@ public:
         if(m_subject != nullptr)
         {
             m_subject->Unsubscribe(*this);
-            assert(m_next == nullptr);
+            assert(m_slot == Dispatcher<Type>::InvalidSlot);
         }
     }
 
-private:
-    void Receive(const Type& event)
+    template<void (*Function)(const Type&)>
+    void Bind()
     {
-        // Call the bound delegate function.
-        this->Invoke(event);
+        BaseDelegate::template Bind<Function>();
+
+        // Update the delegate copy held by the dispatcher.
+        if(m_subject != nullptr)
+        {
+            m_subject->Rebind(*this);
+        }
+    }
+
+    template<class InstanceType, void (InstanceType::*Function)(const Type&)>
+    void Bind(InstanceType* instance)
+    {
+        BaseDelegate::template Bind<InstanceType, Function>(instance);
+
+        // Update the delegate copy held by the dispatcher.
+        if(m_subject != nullptr)
+        {
+            m_subject->Rebind(*this);
+        }
     }
 
 private:
     Dispatcher<Type>* m_subject;
-    Receiver<Type>* m_next;
+    int m_slot;
 };
 
 //
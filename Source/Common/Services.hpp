@@ -1,18 +1,19 @@
 #pragma once
 
 #include "Precompiled.hpp"
+#include "TypeId.hpp"
 
 //
 // Services
 //  Conveniently holds pointers to instances of different types.
+//  Instances are stored in a flat array indexed by type identifiers.
 //
 
 class Services
 {
 public:
     // Type declarations.
-    typedef std::unordered_map<std::type_index, void*> InstanceList;
-    typedef InstanceList::value_type InstancePair;
+    typedef std::vector<void*> InstanceList;
 
 public:
     Services()
@@ -35,25 +36,28 @@ public:
         assert(instance != nullptr);
 
         // Create an instance entry (if it doesn't exists).
-        auto pair = InstancePair(typeid(Type), nullptr);
-        auto result = m_instances.insert(pair);
-        auto it = result.first;
+        int index = TypeId<Type>();
+
+        if(index >= (int)m_instances.size())
+        {
+            m_instances.resize(index + 1, nullptr);
+        }
 
         // Set the instance.
-        it->second = instance;
+        m_instances[index] = instance;
     }
 
     template<typename Type>
     Type* Get() const
     {
         // Find instance of this type.
-        auto it = m_instances.find(typeid(Type));
+        int index = TypeId<Type>();
 
-        if(it == m_instances.end())
+        if(index >= (int)m_instances.size())
             return nullptr;
 
         // Cast and return instance pointer.
-        return reinterpret_cast<Type*>(it->second);
+        return reinterpret_cast<Type*>(m_instances[index]);
     }
 
 private:
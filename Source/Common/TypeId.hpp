@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+//
+// Type Identifier
+//  Assigns a small sequential number to every type it is used with.
+//  Numbers can index flat arrays, which is much cheaper than hashing
+//  std::type_index on every lookup. Numbers are not stable between runs.
+//
+//  Numbers are assigned during static initialization, so they are safe
+//  to read from any thread, but not from other static initializers.
+//
+//  Example usage:
+//      std::vector<void*> instances;
+//      instances.resize(TypeId<Type>() + 1, nullptr);
+//      instances[TypeId<Type>()] = instance;
+//
+
+namespace Detail
+{
+    inline int NextTypeId()
+    {
+        static std::atomic<int> counter(0);
+        return counter++;
+    }
+
+    template<typename Type>
+    struct TypeIdHolder
+    {
+        static const int value;
+    };
+
+    template<typename Type>
+    const int TypeIdHolder<Type>::value = NextTypeId();
+}
+
+template<typename Type>
+int TypeId()
+{
+    return Detail::TypeIdHolder<Type>::value;
+}
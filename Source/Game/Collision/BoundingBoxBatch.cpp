@@ -0,0 +1,53 @@
+#include "Precompiled.hpp"
+#include "BoundingBoxBatch.hpp"
+
+BoundingBoxBatch::BoundingBoxBatch() :
+    m_count(0)
+{
+}
+
+BoundingBoxBatch::~BoundingBoxBatch()
+{
+    Cleanup();
+}
+
+void BoundingBoxBatch::Cleanup()
+{
+    ClearContainer(m_minX);
+    ClearContainer(m_minY);
+    ClearContainer(m_maxX);
+    ClearContainer(m_maxY);
+
+    m_count = 0;
+}
+
+void BoundingBoxBatch::Clear()
+{
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+
+    m_count = 0;
+}
+
+void BoundingBoxBatch::Add(const glm::vec4& box)
+{
+    m_minX.push_back(box.x);
+    m_minY.push_back(box.y);
+    m_maxX.push_back(box.z);
+    m_maxY.push_back(box.w);
+
+    m_count += 1;
+}
+
+void BoundingBoxBatch::Finalize()
+{
+    // Pad arrays with inverted infinite boxes that are separated from any box.
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    m_minX.resize(m_count + Width, infinity);
+    m_minY.resize(m_count + Width, infinity);
+    m_maxX.resize(m_count + Width, -infinity);
+    m_maxY.resize(m_count + Width, -infinity);
+}
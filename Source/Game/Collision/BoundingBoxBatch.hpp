@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+#if defined(_M_X64) || _M_IX86_FP >= 2 || defined(__SSE2__)
+    #define BOUNDING_BOX_BATCH_SSE2
+    #include <emmintrin.h>
+#endif
+
+//
+// Bounding Box Batch
+//  Stores bounding boxes as separate arrays of each coordinate, so one
+//  box can be tested against four boxes at once with SSE2 instructions.
+//  Falls back to scalar tests on platforms without SSE2.
+//
+//  Boxes are stored as (min x, min y, max x, max y) like glm::vec4
+//  bounding boxes. Arrays are padded with boxes that never intersect,
+//  so tests can always read four boxes past the last one.
+//
+
+class BoundingBoxBatch
+{
+public:
+    // Type declarations.
+    typedef std::vector<float> CoordinateList;
+
+    // Number of boxes tested at once.
+    enum
+    {
+        Width = 4,
+    };
+
+public:
+    BoundingBoxBatch();
+    ~BoundingBoxBatch();
+
+    void Cleanup();
+
+    // Removes all boxes while keeping allocated memory.
+    void Clear();
+
+    // Adds a box at the end.
+    void Add(const glm::vec4& box);
+
+    // Pads arrays after all boxes have been added.
+    void Finalize();
+
+    // Tests a box against four boxes starting at index.
+    // Returns a mask with a bit set for every intersecting box.
+    uint32_t Intersect(const glm::vec4& box, int index) const
+    {
+        assert(index >= 0 && index < m_count);
+
+    #ifdef BOUNDING_BOX_BATCH_SSE2
+        // Check if boxes are separated on any axis.
+        __m128 separated = _mm_or_ps(
+            _mm_or_ps(
+                _mm_cmpgt_ps(_mm_set1_ps(box.x), _mm_loadu_ps(&m_maxX[index])),
+                _mm_cmplt_ps(_mm_set1_ps(box.z), _mm_loadu_ps(&m_minX[index]))),
+            _mm_or_ps(
+                _mm_cmpgt_ps(_mm_set1_ps(box.y), _mm_loadu_ps(&m_maxY[index])),
+                _mm_cmplt_ps(_mm_set1_ps(box.w), _mm_loadu_ps(&m_minY[index]))));
+
+        return ~_mm_movemask_ps(separated) & 0xF;
+    #else
+        // Check boxes one by one.
+        uint32_t mask = 0;
+
+        for(int i = 0; i < Width; ++i)
+        {
+            bool separated = box.x > m_maxX[index + i] || box.z < m_minX[index + i] || box.y > m_maxY[index + i] || box.w < m_minY[index + i];
+
+            if(!separated)
+            {
+                mask |= 1 << i;
+            }
+        }
+
+        return mask;
+    #endif
+    }
+
+    glm::vec4 GetBox(int index) const
+    {
+        assert(index >= 0 && index < m_count);
+        return glm::vec4(m_minX[index], m_minY[index], m_maxX[index], m_maxY[index]);
+    }
+
+    float GetMinX(int index) const
+    {
+        return m_minX[index];
+    }
+
+    int GetCount() const
+    {
+        return m_count;
+    }
+
+private:
+    // Box coordinates.
+    CoordinateList m_minX;
+    CoordinateList m_minY;
+    CoordinateList m_maxX;
+    CoordinateList m_maxY;
+
+    // Number of boxes.
+    int m_count;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Precompiled.hpp"
+#include "CollisionObject.hpp"
+
+// Forward declarations.
+class JobSystem;
+
+//
+// Collision Broad Phase
+//  Base interface for finding pairs of collision objects that can
+//  potentially collide. Only objects with overlapping bounding boxes
+//  where at least one can collide with the other are reported.
+//
+
+class CollisionBroadPhase
+{
+public:
+    // Type declarations.
+    typedef std::vector<CollisionObject> ObjectList;
+    typedef std::pair<int, int> ObjectPair;
+    typedef std::vector<ObjectPair> PairList;
+
+public:
+    virtual ~CollisionBroadPhase()
+    {
+    }
+
+    // Appends pairs of object indices with the lower index first.
+    // Work can be split between worker threads if a job system is provided.
+    virtual void FindPairs(const ObjectList& objects, PairList& pairs, JobSystem* jobSystem) = 0;
+};
@@ -3,9 +3,12 @@
 
 CollisionComponent::CollisionComponent() :
     m_boundingBox(0.0f),
+    m_shape(CollisionShapes::Box),
     m_type(0),
     m_mask(0),
-    m_flags(CollisionFlags::Default)
+    m_flags(CollisionFlags::Default),
+    m_lastPosition(0.0f, 0.0f),
+    m_lastPositionValid(false)
 {
 }
 
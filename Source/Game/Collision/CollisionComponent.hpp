@@ -18,13 +18,35 @@ struct CollisionFlags
 
         // Collision events will be generated when object doesn't collide instead.
         Reversed = 1 << 1,
+
+        // Collisions will be tested along the path traveled since the last update.
+        // Prevents fast moving objects from passing through thin objects.
+        FastMoving = 1 << 2,
     };
 
     static const uint32_t Default = Enabled; 
 };
 
+//
+// Collision Shapes
+//
+
+struct CollisionShapes
+{
+    enum Type
+    {
+        // Box that rotates with the entity.
+        Box,
+
+        // Circle inscribed in the bounding box.
+        Circle,
+    };
+};
+
 //
 // Collision Component
+//  Bounding box is defined in world units relative to the entity
+//  position and is rotated along with the entity transform.
 //
 
 class CollisionComponent : public Component
@@ -52,6 +74,16 @@ public:
         return m_boundingBox;
     }
 
+    void SetShape(CollisionShapes::Type shape)
+    {
+        m_shape = shape;
+    }
+
+    CollisionShapes::Type GetShape() const
+    {
+        return m_shape;
+    }
+
     void SetType(BitField type)
     {
         m_type = type;
@@ -97,14 +129,43 @@ public:
         return m_flags & CollisionFlags::Enabled;
     }
 
+    bool IsFastMoving() const
+    {
+        return (m_flags & CollisionFlags::FastMoving) != 0;
+    }
+
+    // Tracks the position from the last collision update.
+    void SetLastPosition(const glm::vec2& position)
+    {
+        m_lastPosition = position;
+        m_lastPositionValid = true;
+    }
+
+    const glm::vec2& GetLastPosition() const
+    {
+        return m_lastPosition;
+    }
+
+    bool HasLastPosition() const
+    {
+        return m_lastPositionValid;
+    }
+
 private:
     // Collision bounding box.
     glm::vec4 m_boundingBox;
 
+    // Collision shape.
+    CollisionShapes::Type m_shape;
+
     // Collision bits.
     BitField m_type;
     BitField m_mask;
 
     // Collision flags.
     BitField m_flags;
+
+    // Position from the last collision update.
+    glm::vec2 m_lastPosition;
+    bool m_lastPositionValid;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Precompiled.hpp"
+#include "CollisionShape.hpp"
 
 #include "Game/Entity/EntityHandle.hpp"
 
@@ -19,5 +20,11 @@ struct CollisionObject
     TransformComponent* transform;
     CollisionComponent* collision;
     glm::vec4 worldAABB;
+    CollisionShape worldShape;
+
+    // Movement since the last update and a bounding box enclosing it.
+    // Only calculated for fast moving objects.
+    glm::vec2 displacement;
+    glm::vec4 sweptAABB;
     bool enabled;
 };
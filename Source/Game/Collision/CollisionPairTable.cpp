@@ -0,0 +1,272 @@
+#include "Precompiled.hpp"
+#include "CollisionPairTable.hpp"
+
+#include "Game/Entity/EntitySystem.hpp"
+
+namespace
+{
+    // Table parameters.
+    const int InitialCapacity = 64;
+    const int SweepCount = 32;
+
+    // Timing wheel parameters.
+    const int WheelSize = 512;
+    const double TickLength = 1.0 / 128.0;
+
+    bool IsEmpty(const CollisionPairTable::Entry& entry)
+    {
+        return entry.pair.first.identifier == 0;
+    }
+}
+
+CollisionPairTable::CollisionPairTable() :
+    m_count(0),
+    m_currentTick(0),
+    m_currentTime(0.0),
+    m_sweepIndex(0)
+{
+}
+
+CollisionPairTable::~CollisionPairTable()
+{
+    Cleanup();
+}
+
+void CollisionPairTable::Cleanup()
+{
+    ClearContainer(m_entries);
+    ClearContainer(m_wheel);
+
+    m_count = 0;
+    m_currentTick = 0;
+    m_currentTime = 0.0;
+    m_sweepIndex = 0;
+}
+
+void CollisionPairTable::Insert(const EntityPair& pair, float duration)
+{
+    // Invalid source handle marks empty slots.
+    if(pair.first.identifier == 0)
+        return;
+
+    // Make sure the load factor stays below a half.
+    if((m_count + 1) * 2 > (int)m_entries.size())
+    {
+        Grow();
+    }
+
+    // Find an existing entry or an empty slot.
+    std::size_t mask = m_entries.size() - 1;
+    std::size_t slot = GetSlot(pair);
+
+    while(!IsEmpty(m_entries[slot]) && m_entries[slot].pair != pair)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    Entry& entry = m_entries[slot];
+
+    if(!IsEmpty(entry))
+    {
+        // Update the duration if it's longer.
+        float time = entry.expiration < 0.0 ? -1.0f : (float)(entry.expiration - m_currentTime);
+
+        if(time < duration)
+        {
+            entry.expiration = m_currentTime + duration;
+            ScheduleTimer(pair, entry.expiration);
+        }
+    }
+    else
+    {
+        // Insert a new entry.
+        entry.pair = pair;
+        entry.expiration = duration < 0.0f ? -1.0 : m_currentTime + duration;
+
+        if(duration >= 0.0f)
+        {
+            ScheduleTimer(pair, entry.expiration);
+        }
+
+        m_count += 1;
+    }
+}
+
+bool CollisionPairTable::Contains(const EntityPair& pair) const
+{
+    return Find(pair) >= 0;
+}
+
+void CollisionPairTable::Update(float timeDelta, const EntitySystem& entitySystem)
+{
+    if(m_count == 0)
+        return;
+
+    // Advance the current time.
+    m_currentTime += timeDelta;
+
+    int64_t currentTick = (int64_t)std::floor(m_currentTime / TickLength);
+
+    // Process timers of passed ticks. The current tick is processed again
+    // next time, because timers can still be scheduled for it.
+    int64_t tickCount = std::min<int64_t>(currentTick - m_currentTick + 1, WheelSize);
+
+    for(int64_t tick = currentTick - tickCount + 1; tick <= currentTick; ++tick)
+    {
+        TimerList& timers = m_wheel[(std::size_t)(tick % WheelSize)];
+
+        for(std::size_t i = 0; i < timers.size(); /* inloop */)
+        {
+            Timer& timer = timers[i];
+
+            // Keep timers that expire in later rounds of the wheel.
+            if(timer.expiration > m_currentTime)
+            {
+                ++i;
+                continue;
+            }
+
+            // Erase the entry unless its duration has been changed.
+            int index = Find(timer.pair);
+
+            if(index >= 0 && m_entries[index].expiration == timer.expiration)
+            {
+                Erase(index);
+            }
+
+            // Remove the timer.
+            timer = timers.back();
+            timers.pop_back();
+        }
+    }
+
+    m_currentTick = currentTick;
+
+    // Remove a few entries of destroyed entities.
+    for(int i = 0; i < SweepCount && m_count > 0; ++i)
+    {
+        m_sweepIndex = m_sweepIndex % m_entries.size();
+
+        const Entry& entry = m_entries[m_sweepIndex];
+
+        if(!IsEmpty(entry))
+        {
+            if(!entitySystem.IsHandleValid(entry.pair.first) || !entitySystem.IsHandleValid(entry.pair.second))
+            {
+                // Check the same slot again as erasing can move another entry into it.
+                Erase(m_sweepIndex);
+                continue;
+            }
+        }
+
+        m_sweepIndex += 1;
+    }
+}
+
+int CollisionPairTable::GetCount() const
+{
+    return m_count;
+}
+
+int CollisionPairTable::Find(const EntityPair& pair) const
+{
+    if(m_count == 0)
+        return -1;
+
+    // Probe slots until an empty one is found.
+    std::size_t mask = m_entries.size() - 1;
+    std::size_t slot = GetSlot(pair);
+
+    while(!IsEmpty(m_entries[slot]))
+    {
+        if(m_entries[slot].pair == pair)
+            return (int)slot;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return -1;
+}
+
+void CollisionPairTable::Erase(int index)
+{
+    assert(!IsEmpty(m_entries[index]));
+
+    // Shift following entries back to fill the hole, so no tombstones are needed.
+    std::size_t mask = m_entries.size() - 1;
+    std::size_t hole = index;
+    std::size_t slot = index;
+
+    while(true)
+    {
+        slot = (slot + 1) & mask;
+
+        if(IsEmpty(m_entries[slot]))
+            break;
+
+        // Leave entries that would be probed past the hole.
+        std::size_t home = GetSlot(m_entries[slot].pair);
+
+        bool between = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+
+        if(between)
+            continue;
+
+        // Move the entry into the hole.
+        m_entries[hole] = m_entries[slot];
+        hole = slot;
+    }
+
+    m_entries[hole] = Entry();
+    m_count -= 1;
+}
+
+void CollisionPairTable::Grow()
+{
+    // Allocate the timing wheel.
+    if(m_wheel.empty())
+    {
+        m_wheel.resize(WheelSize);
+    }
+
+    // Double the capacity.
+    EntryList entries(std::max<std::size_t>(InitialCapacity, m_entries.size() * 2));
+    m_entries.swap(entries);
+
+    // Reinsert existing entries.
+    std::size_t mask = m_entries.size() - 1;
+
+    for(const Entry& entry : entries)
+    {
+        if(IsEmpty(entry))
+            continue;
+
+        std::size_t slot = GetSlot(entry.pair);
+
+        while(!IsEmpty(m_entries[slot]))
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        m_entries[slot] = entry;
+    }
+
+    m_sweepIndex = 0;
+}
+
+void CollisionPairTable::ScheduleTimer(const EntityPair& pair, double expiration)
+{
+    // Add the timer to the slot of the tick it expires in.
+    int64_t tick = std::max(m_currentTick, (int64_t)std::floor(expiration / TickLength));
+
+    Timer timer;
+    timer.pair = pair;
+    timer.expiration = expiration;
+
+    m_wheel[(std::size_t)(tick % WheelSize)].push_back(timer);
+}
+
+std::size_t CollisionPairTable::GetSlot(const EntityPair& pair) const
+{
+    return std::hash<EntityPair>()(pair) & (m_entries.size() - 1);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+#include "Game/Entity/EntityHandle.hpp"
+
+// Forward declarations.
+class EntitySystem;
+
+//
+// Collision Pair Table
+//  Flat hash table of entity pairs with expiration timers stored inline.
+//  Uses open addressing with linear probing, so lookups never allocate.
+//  Timed entries are expired by a timing wheel without scanning the table.
+//  Entries of destroyed entities are removed by an incremental sweep.
+//
+
+class CollisionPairTable
+{
+public:
+    // Type declarations.
+    typedef std::pair<EntityHandle, EntityHandle> EntityPair;
+
+    struct Entry
+    {
+        Entry() :
+            expiration(0.0)
+        {
+        }
+
+        EntityPair pair;
+        double expiration;
+    };
+
+    struct Timer
+    {
+        EntityPair pair;
+        double expiration;
+    };
+
+    typedef std::vector<Entry> EntryList;
+    typedef std::vector<Timer> TimerList;
+    typedef std::vector<TimerList> TimerWheel;
+
+public:
+    CollisionPairTable();
+    ~CollisionPairTable();
+
+    void Cleanup();
+
+    // Inserts a pair or extends the duration of an existing one.
+    // Pairs with a negative duration never expire.
+    void Insert(const EntityPair& pair, float duration);
+
+    // Checks if a pair is in the table.
+    bool Contains(const EntityPair& pair) const;
+
+    // Advances timers and removes expired entries.
+    void Update(float timeDelta, const EntitySystem& entitySystem);
+
+    // Gets the number of entries.
+    int GetCount() const;
+
+private:
+    int Find(const EntityPair& pair) const;
+    void Erase(int index);
+    void Grow();
+    void ScheduleTimer(const EntityPair& pair, double expiration);
+    std::size_t GetSlot(const EntityPair& pair) const;
+
+private:
+    // Table of entries.
+    EntryList m_entries;
+    int m_count;
+
+    // Timing wheel of expirations.
+    TimerWheel m_wheel;
+    int64_t m_currentTick;
+    double m_currentTime;
+
+    // Position of the incremental sweep.
+    int m_sweepIndex;
+};
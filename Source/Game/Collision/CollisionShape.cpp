@@ -0,0 +1,220 @@
+#include "Precompiled.hpp"
+#include "CollisionShape.hpp"
+#include "CollisionComponent.hpp"
+
+#include "Game/Transform/TransformComponent.hpp"
+
+namespace
+{
+    //
+    // Shape Tests
+    //  Specialized for every pair of shape kinds at compile time.
+    //
+
+    template<CollisionShape::Kind First, CollisionShape::Kind Second>
+    struct ShapeTest;
+
+    // Projects box half extents on an axis.
+    float ProjectBox(const CollisionShape& box, const glm::vec2& axis)
+    {
+        return box.extents.x * glm::abs(glm::dot(box.axes[0], axis)) + box.extents.y * glm::abs(glm::dot(box.axes[1], axis));
+    }
+
+    // Checks if boxes are separated along an axis.
+    bool IsSeparated(const CollisionShape& a, const CollisionShape& b, const glm::vec2& axis)
+    {
+        float distance = glm::abs(glm::dot(b.center - a.center, axis));
+        return distance > ProjectBox(a, axis) + ProjectBox(b, axis);
+    }
+
+    template<>
+    struct ShapeTest<CollisionShape::AlignedBox, CollisionShape::AlignedBox>
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            glm::vec2 distance = glm::abs(b.center - a.center);
+            return !(distance.x > a.extents.x + b.extents.x || distance.y > a.extents.y + b.extents.y);
+        }
+    };
+
+    template<>
+    struct ShapeTest<CollisionShape::OrientedBox, CollisionShape::OrientedBox>
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            // Check separating axes of both boxes.
+            if(IsSeparated(a, b, a.axes[0]) || IsSeparated(a, b, a.axes[1]))
+                return false;
+
+            if(IsSeparated(a, b, b.axes[0]) || IsSeparated(a, b, b.axes[1]))
+                return false;
+
+            return true;
+        }
+    };
+
+    template<>
+    struct ShapeTest<CollisionShape::OrientedBox, CollisionShape::AlignedBox>
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            // Axes of the aligned box are the world axes.
+            if(IsSeparated(a, b, glm::vec2(1.0f, 0.0f)) || IsSeparated(a, b, glm::vec2(0.0f, 1.0f)))
+                return false;
+
+            if(IsSeparated(a, b, a.axes[0]) || IsSeparated(a, b, a.axes[1]))
+                return false;
+
+            return true;
+        }
+    };
+
+    template<>
+    struct ShapeTest<CollisionShape::AlignedBox, CollisionShape::Circle>
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            // Find the closest point of the box to the circle center.
+            glm::vec2 closest = glm::clamp(b.center, a.center - a.extents, a.center + a.extents);
+
+            glm::vec2 distance = b.center - closest;
+            return glm::dot(distance, distance) <= b.radius * b.radius;
+        }
+    };
+
+    template<>
+    struct ShapeTest<CollisionShape::OrientedBox, CollisionShape::Circle>
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            // Transform the circle center to the box space.
+            glm::vec2 offset = b.center - a.center;
+            glm::vec2 local(glm::dot(offset, a.axes[0]), glm::dot(offset, a.axes[1]));
+
+            // Find the closest point of the box to the circle center.
+            glm::vec2 closest = glm::clamp(local, -a.extents, a.extents);
+
+            glm::vec2 distance = local - closest;
+            return glm::dot(distance, distance) <= b.radius * b.radius;
+        }
+    };
+
+    template<>
+    struct ShapeTest<CollisionShape::Circle, CollisionShape::Circle>
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            glm::vec2 distance = b.center - a.center;
+            float radius = a.radius + b.radius;
+
+            return glm::dot(distance, distance) <= radius * radius;
+        }
+    };
+
+    // Reuses a test of the same shapes in reversed order.
+    template<CollisionShape::Kind First, CollisionShape::Kind Second>
+    struct ShapeTest
+    {
+        static bool Intersect(const CollisionShape& a, const CollisionShape& b)
+        {
+            return ShapeTest<Second, First>::Intersect(b, a);
+        }
+    };
+
+    // Table of shape tests indexed by shape kinds.
+    typedef bool (*ShapeTestFunction)(const CollisionShape&, const CollisionShape&);
+
+    const ShapeTestFunction ShapeTests[CollisionShape::KindCount][CollisionShape::KindCount] =
+    {
+        {
+            &ShapeTest<CollisionShape::AlignedBox, CollisionShape::AlignedBox>::Intersect,
+            &ShapeTest<CollisionShape::AlignedBox, CollisionShape::OrientedBox>::Intersect,
+            &ShapeTest<CollisionShape::AlignedBox, CollisionShape::Circle>::Intersect,
+        },
+        {
+            &ShapeTest<CollisionShape::OrientedBox, CollisionShape::AlignedBox>::Intersect,
+            &ShapeTest<CollisionShape::OrientedBox, CollisionShape::OrientedBox>::Intersect,
+            &ShapeTest<CollisionShape::OrientedBox, CollisionShape::Circle>::Intersect,
+        },
+        {
+            &ShapeTest<CollisionShape::Circle, CollisionShape::AlignedBox>::Intersect,
+            &ShapeTest<CollisionShape::Circle, CollisionShape::OrientedBox>::Intersect,
+            &ShapeTest<CollisionShape::Circle, CollisionShape::Circle>::Intersect,
+        },
+    };
+}
+
+void CalculateCollisionShape(CollisionShape* shape, glm::vec4* boundingBox, const CollisionComponent* collision, const TransformComponent* transform)
+{
+    assert(shape != nullptr);
+    assert(boundingBox != nullptr);
+    assert(collision != nullptr);
+    assert(transform != nullptr);
+
+    const glm::vec4& localBox = collision->GetBoundingBox();
+    const glm::vec2& position = transform->GetPosition();
+
+    // Translate the bounding box of an unrotated box shape.
+    if(collision->GetShape() == CollisionShapes::Box && transform->GetRotation() == 0.0f)
+    {
+        *boundingBox = localBox;
+        boundingBox->x += position.x;
+        boundingBox->y += position.y;
+        boundingBox->z += position.x;
+        boundingBox->w += position.y;
+
+        shape->kind = CollisionShape::AlignedBox;
+        shape->center = glm::vec2(boundingBox->x + boundingBox->z, boundingBox->y + boundingBox->w) * 0.5f;
+        shape->axes[0] = glm::vec2(1.0f, 0.0f);
+        shape->axes[1] = glm::vec2(0.0f, 1.0f);
+        shape->extents = glm::vec2(boundingBox->z - boundingBox->x, boundingBox->w - boundingBox->y) * 0.5f;
+        shape->radius = 0.0f;
+
+        return;
+    }
+
+    // Calculate rotated axes, the same way the transform matrix rotates clockwise.
+    float angle = glm::radians(transform->GetRotation());
+    float sine = glm::sin(angle);
+    float cosine = glm::cos(angle);
+
+    glm::vec2 axisX(cosine, -sine);
+    glm::vec2 axisY(sine, cosine);
+
+    // Rotate the local shape center around the entity position.
+    glm::vec2 localCenter = glm::vec2(localBox.x + localBox.z, localBox.y + localBox.w) * 0.5f;
+    glm::vec2 localExtents = glm::vec2(localBox.z - localBox.x, localBox.w - localBox.y) * 0.5f;
+
+    shape->center = position + axisX * localCenter.x + axisY * localCenter.y;
+    shape->axes[0] = axisX;
+    shape->axes[1] = axisY;
+    shape->extents = localExtents;
+
+    glm::vec2 boundingExtents;
+
+    if(collision->GetShape() == CollisionShapes::Circle)
+    {
+        shape->kind = CollisionShape::Circle;
+        shape->radius = glm::min(localExtents.x, localExtents.y);
+
+        boundingExtents = glm::vec2(shape->radius);
+    }
+    else
+    {
+        shape->kind = CollisionShape::OrientedBox;
+        shape->radius = 0.0f;
+
+        boundingExtents = glm::abs(axisX) * localExtents.x + glm::abs(axisY) * localExtents.y;
+    }
+
+    // Calculate the world bounding box of the shape.
+    boundingBox->x = shape->center.x - boundingExtents.x;
+    boundingBox->y = shape->center.y - boundingExtents.y;
+    boundingBox->z = shape->center.x + boundingExtents.x;
+    boundingBox->w = shape->center.y + boundingExtents.y;
+}
+
+bool IntersectCollisionShapes(const CollisionShape& a, const CollisionShape& b)
+{
+    return ShapeTests[a.kind][b.kind](a, b);
+}
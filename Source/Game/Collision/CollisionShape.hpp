@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+// Forward declarations.
+class TransformComponent;
+class CollisionComponent;
+
+//
+// Collision Shape
+//  Shape of a collision object in world space, calculated once per frame.
+//  Boxes of entities that aren't rotated are kept axis aligned, so they
+//  can be tested with a simple bounding box test.
+//
+
+struct CollisionShape
+{
+    enum Kind
+    {
+        AlignedBox,
+        OrientedBox,
+        Circle,
+
+        KindCount,
+    };
+
+    // Shape kind.
+    Kind kind;
+
+    // Shape center.
+    glm::vec2 center;
+
+    // Box axes and half extents along them.
+    glm::vec2 axes[2];
+    glm::vec2 extents;
+
+    // Circle radius.
+    float radius;
+};
+
+// Calculates a world shape and its bounding box.
+void CalculateCollisionShape(CollisionShape* shape, glm::vec4* boundingBox, const CollisionComponent* collision, const TransformComponent* transform);
+
+// Checks if shapes intersect. Touching shapes are considered intersecting.
+bool IntersectCollisionShapes(const CollisionShape& a, const CollisionShape& b);
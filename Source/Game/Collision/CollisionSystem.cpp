@@ -1,34 +1,151 @@
 #include "Precompiled.hpp"
 #include "CollisionSystem.hpp"
 #include "CollisionComponent.hpp"
+#include "SweepAndPrune.hpp"
 
+#include "MainGlobal.hpp"
 #include "Common/Services.hpp"
+#include "Common/JobSystem.hpp"
 #include "Game/Event/EventDefinitions.hpp"
 #include "Game/Event/EventSystem.hpp"
 #include "Game/Entity/EntitySystem.hpp"
 #include "Game/Component/ComponentSystem.hpp"
+#include "Game/Health/HealthSystem.hpp"
 #include "Game/Transform/TransformComponent.hpp"
 
-namespace
+namespace Console
 {
-    void TransformBoundingBox(glm::vec4* boundingBox, const TransformComponent* transform)
-    {
-        assert(boundingBox != nullptr);
+    ConsoleVariable parallelCollision("g_parallelcollision", true, "Runs collision tests on worker threads.");
+}
 
-        // Translate by position.
-        boundingBox->x += transform->GetPosition().x;
-        boundingBox->y += transform->GetPosition().y;
-        boundingBox->z += transform->GetPosition().x;
-        boundingBox->w += transform->GetPosition().y;
+namespace
+{
+    // Number of elements processed by a single job.
+    const int PairBatchSize = 1024;
+    const int ObjectBatchSize = 64;
 
-        // Todo: Handle rotation and scale.
-    }
+    // Maximum number of exact shape tests along a swept path.
+    const int MaxSweepSteps = 16;
 
     bool IntersectBoundingBox(const glm::vec4& a, const glm::vec4& b)
     {
         // Check if bounding boxes collide.
         return !(a.x > b.z || a.z < b.x || a.y > b.w || a.w < b.y);
     }
+
+    bool IsAlignedBox(const CollisionObject& object)
+    {
+        return object.worldShape.kind == CollisionShape::AlignedBox;
+    }
+
+    bool IntersectShapes(const CollisionObject& a, const CollisionObject& b)
+    {
+        // Use a simple bounding box test if both shapes are axis aligned boxes.
+        if(IsAlignedBox(a) && IsAlignedBox(b))
+            return IntersectBoundingBox(a.worldAABB, b.worldAABB);
+
+        // Check if bounding boxes collide before testing shapes.
+        if(!IntersectBoundingBox(a.worldAABB, b.worldAABB))
+            return false;
+
+        return IntersectCollisionShapes(a.worldShape, b.worldShape);
+    }
+
+    float GetShapeSize(const CollisionShape& shape)
+    {
+        // Get the smallest distance from the center to the shape edge.
+        if(shape.kind == CollisionShape::Circle)
+            return shape.radius;
+
+        return std::min(shape.extents.x, shape.extents.y);
+    }
+
+    bool IsFastMoving(const CollisionObject& object)
+    {
+        return object.displacement != glm::vec2(0.0f, 0.0f);
+    }
+
+    bool IsSimple(const CollisionObject& object)
+    {
+        return IsAlignedBox(object) && !IsFastMoving(object);
+    }
+
+    bool IntersectSwept(const CollisionObject& a, const CollisionObject& b)
+    {
+        // Move the first box relative to the other one from their last positions.
+        glm::vec4 first = a.worldAABB - glm::vec4(a.displacement, a.displacement);
+        glm::vec4 second = b.worldAABB - glm::vec4(b.displacement, b.displacement);
+        glm::vec2 movement = a.displacement - b.displacement;
+
+        // Find the time interval when boxes overlap on both axes.
+        float enter = 0.0f;
+        float exit = 1.0f;
+
+        for(int axis = 0; axis < 2; ++axis)
+        {
+            float firstMin = first[axis];
+            float firstMax = first[axis + 2];
+            float secondMin = second[axis];
+            float secondMax = second[axis + 2];
+
+            if(movement[axis] == 0.0f)
+            {
+                // Boxes must already overlap on a stationary axis.
+                if(firstMin > secondMax || firstMax < secondMin)
+                    return false;
+            }
+            else
+            {
+                // Calculate times of entering and exiting the overlap on this axis.
+                float axisEnter = (secondMin - firstMax) / movement[axis];
+                float axisExit = (secondMax - firstMin) / movement[axis];
+
+                if(axisEnter > axisExit)
+                {
+                    std::swap(axisEnter, axisExit);
+                }
+
+                enter = std::max(enter, axisEnter);
+                exit = std::min(exit, axisExit);
+
+                if(enter > exit)
+                    return false;
+            }
+        }
+
+        // Swept bounding boxes are exact for axis aligned boxes.
+        if(IsAlignedBox(a) && IsAlignedBox(b))
+            return true;
+
+        // Test exact shapes along the overlap interval, starting at the time of impact.
+        // Steps are kept shorter than the smaller shape so it can't skip over the other one.
+        float distance = glm::length(movement) * (exit - enter);
+        float size = std::min(GetShapeSize(a.worldShape), GetShapeSize(b.worldShape));
+
+        int steps = MaxSweepSteps;
+
+        if(size > 0.0f)
+        {
+            steps = std::min(MaxSweepSteps, 1 + (int)(distance / size));
+        }
+
+        for(int i = 0; i <= steps; ++i)
+        {
+            float time = enter + (exit - enter) * i / steps;
+
+            // Move shapes back from their current positions.
+            CollisionShape first = a.worldShape;
+            first.center -= a.displacement * (1.0f - time);
+
+            CollisionShape second = b.worldShape;
+            second.center -= b.displacement * (1.0f - time);
+
+            if(IntersectCollisionShapes(first, second))
+                return true;
+        }
+
+        return false;
+    }
 }
 
 const float CollisionSystem::Permanent = -1.0f;
@@ -37,7 +154,8 @@ CollisionSystem::CollisionSystem() :
     m_initialized(false),
     m_eventSystem(nullptr),
     m_entitySystem(nullptr),
-    m_componentSystem(nullptr)
+    m_componentSystem(nullptr),
+    m_healthSystem(nullptr)
 {
 }
 
@@ -53,9 +171,19 @@ void CollisionSystem::Cleanup()
     m_eventSystem = nullptr;
     m_entitySystem = nullptr;
     m_componentSystem = nullptr;
+    m_healthSystem = nullptr;
 
     ClearContainer(m_objects);
-    ClearContainer(m_disabled);
+    ClearContainer(m_entities);
+    ClearContainer(m_validity);
+    m_boxes.Cleanup();
+    ClearContainer(m_pairs);
+    ClearContainer(m_contacts);
+    ClearContainer(m_batches);
+    ClearContainer(m_dispatched);
+    m_disabled.Cleanup();
+
+    m_broadPhase = nullptr;
 }
 
 bool CollisionSystem::Initialize(const Services& services)
@@ -75,10 +203,16 @@ bool CollisionSystem::Initialize(const Services& services)
     m_componentSystem = services.Get<ComponentSystem>();
     if(m_componentSystem == nullptr) return false;
 
+    m_healthSystem = services.Get<HealthSystem>();
+    if(m_healthSystem == nullptr) return false;
+
     // Declare required components.
     m_componentSystem->Declare<TransformComponent>();
     m_componentSystem->Declare<CollisionComponent>();
 
+    // Create the broad phase.
+    m_broadPhase = std::make_unique<SweepAndPrune>();
+
     // Success!
     return m_initialized = true;
 }
@@ -88,164 +222,295 @@ void CollisionSystem::Update(float timeDelta)
     assert(m_initialized);
 
     // Update timers of disabled collision response pairs.
-    for(auto it = m_disabled.begin(); it != m_disabled.end();)
-    {
-        const EntityHandle& sourceEntity = it->first.first;
-        const EntityHandle& targetEntity = it->first.second;
-
-        float& time = it->second;
-
-        // Check if entities are still valid.
-        bool sourceEntityValid = m_entitySystem->IsHandleValid(sourceEntity);
-        bool targetEntityValid = m_entitySystem->IsHandleValid(targetEntity);
-
-        if(!sourceEntityValid || !targetEntityValid)
-        {
-            m_disabled.erase(it++);
-            continue;
-        }
-
-        // Skip if it has been disabled permanently.
-        if(time < 0.0f)
-            continue;
-
-        // Update the timer.
-        time = std::max(0.0f, time - timeDelta);
-
-        // Erase the element if outdated.
-        if(time == 0.0f)
-        {
-            m_disabled.erase(it++);
-            continue;
-        }
-
-        // Iterate normally if current element hasn't been removed.
-        ++it;
-    }
+    m_disabled.Update(timeDelta, *m_entitySystem);
 
     // Create a list of collision objects.
-    auto componentsBegin = m_componentSystem->Begin<CollisionComponent>();
-    auto componentsEnd = m_componentSystem->End<CollisionComponent>();
+    auto view = m_componentSystem->View<TransformComponent, CollisionComponent>();
 
-    for(auto it = componentsBegin; it != componentsEnd; ++it)
+    for(auto it = view.Begin(); it != view.End(); ++it)
     {
-        // Check if entity is active.
-        if(!m_entitySystem->IsHandleValid(it->first))
-            continue;
-
         // Get the collision component.
-        CollisionComponent* collision = &it->second;
+        CollisionComponent* collision = &it.Get<CollisionComponent>();
 
         if(!collision->IsEnabled())
             continue;
 
         // Get the transform component.
-        TransformComponent* transform = m_componentSystem->Lookup<TransformComponent>(it->first);
-
-        if(transform == nullptr)
-            continue;
-
-        // Transform the bounding box to world space.
-        glm::vec4 boundingBox = collision->GetBoundingBox();
-        TransformBoundingBox(&boundingBox, transform);
+        TransformComponent* transform = &it.Get<TransformComponent>();
 
         // Add a collision object.
         CollisionObject object;
-        object.entity = it->first;
+        object.entity = it.GetEntity();
         object.transform = transform;
         object.collision = collision;
-        object.worldAABB = boundingBox;
         object.enabled = true;
 
         m_objects.push_back(object);
+        m_entities.push_back(object.entity);
     }
 
-    // Process collision objects.
-    for(auto it = m_objects.begin(); it != m_objects.end(); ++it)
+    // Check which entities are active all at once.
+    m_entitySystem->ValidateHandles(m_entities.data(), (int)m_entities.size(), m_validity);
+
+    // Remove objects of inactive entities and calculate shapes of the rest.
+    int objectCount = 0;
+
+    for(int i = 0; i < (int)m_objects.size(); ++i)
     {
-        // Check if collision object is still enabled.
-        if(!it->enabled)
+        if(!EntitySystem::IsMaskSet(m_validity, i))
             continue;
 
-        // Check if it collides with other objects.
-        for(auto other = m_objects.begin(); other != m_objects.end(); ++other)
+        CollisionObject& object = m_objects[objectCount++];
+        object = m_objects[i];
+
+        CollisionComponent* collision = object.collision;
+        TransformComponent* transform = object.transform;
+
+        // Calculate the shape and its bounding box in world space.
+        CalculateCollisionShape(&object.worldShape, &object.worldAABB, collision, transform);
+
+        // Calculate the path traveled by a fast moving object.
+        object.displacement = glm::vec2(0.0f, 0.0f);
+        object.sweptAABB = object.worldAABB;
+
+        if(collision->IsFastMoving())
         {
-            // Don't check against itself.
-            if(other == it)
-                continue;
+            if(collision->HasLastPosition())
+            {
+                object.displacement = transform->GetPosition() - collision->GetLastPosition();
 
-            // Check if collision response with other entity has been disabled.
-            // This shouldn't be here before actuall collision calculation, but
-            // we only do a collision response (no physical interaction) so it's
-            // totally fine for now (we skip the expensive calculation).
-            EntityPair pair = { it->entity, other->entity };
+                object.sweptAABB.x -= std::max(0.0f, object.displacement.x);
+                object.sweptAABB.y -= std::max(0.0f, object.displacement.y);
+                object.sweptAABB.z -= std::min(0.0f, object.displacement.x);
+                object.sweptAABB.w -= std::min(0.0f, object.displacement.y);
+            }
 
-            if(m_disabled.count(pair) == 1)
-                continue;
+            collision->SetLastPosition(transform->GetPosition());
+        }
+
+        m_boxes.Add(object.sweptAABB);
+    }
+
+    m_objects.resize(objectCount);
+    m_boxes.Finalize();
+
+    // Get the job system if collision tests can run in parallel.
+    JobSystem* jobSystem = nullptr;
+
+    if(Console::parallelCollision && Main::GetJobSystem().GetWorkerCount() > 0)
+    {
+        jobSystem = &Main::GetJobSystem();
+    }
+
+    // Find pairs of objects that can potentially collide.
+    m_broadPhase->FindPairs(m_objects, m_pairs, jobSystem);
+
+    // Test pairs in both directions for objects that can collide with each other.
+    RunBatches((int)m_pairs.size(), PairBatchSize, jobSystem, [this](int begin, int end, PairList& contacts)
+    {
+        for(int i = begin; i < end; ++i)
+        {
+            const ObjectPair& pair = m_pairs[i];
+
+            if(TestContact(m_objects[pair.first], m_objects[pair.second]))
+            {
+                contacts.push_back(pair);
+            }
+
+            if(TestContact(m_objects[pair.second], m_objects[pair.first]))
+            {
+                contacts.push_back(std::make_pair(pair.second, pair.first));
+            }
+        }
+    });
+
+    // Reversed objects generate events when they don't intersect,
+    // so they have to be tested against every other object.
+    RunBatches((int)m_objects.size(), ObjectBatchSize, jobSystem, [this](int begin, int end, PairList& contacts)
+    {
+        for(int i = begin; i < end; ++i)
+        {
+            const CollisionObject& object = m_objects[i];
 
-            // Check if collision object is still enabled.
-            if(!other->enabled)
+            if(!(object.collision->GetFlags() & CollisionFlags::Reversed))
                 continue;
 
-            // Check if an object can collide with it.
-            if(it->collision->GetMask() & other->collision->GetType())
+            for(int j = 0; j < m_boxes.GetCount(); j += BoundingBoxBatch::Width)
             {
-                // Check if objects physically and logically collide.
-                bool intersects = IntersectBoundingBox(it->worldAABB, other->worldAABB);
-                bool reversed = (it->collision->GetFlags() & CollisionFlags::Reversed) != 0;
+                // Check which objects this one can collide with
+                // before testing their bounding boxes.
+                uint32_t candidates = 0;
+                int count = std::min<int>(BoundingBoxBatch::Width, m_boxes.GetCount() - j);
 
-                if(intersects != reversed)
+                for(int k = 0; k < count; ++k)
                 {
-                    // Dispatch an entity collision event.
+                    int other = j + k;
+
+                    if(other != i && (object.collision->GetMask() & m_objects[other].collision->GetType()))
                     {
-                        GameEvent::EntityCollision event(*it, *other);
-                        m_eventSystem->Dispatch(event);
+                        candidates |= 1 << k;
                     }
+                }
+
+                if(candidates == 0)
+                    continue;
+
+                // Test against a few objects at once.
+                uint32_t hits = m_boxes.Intersect(object.worldAABB, j);
+
+                for(int k = 0; k < count; ++k)
+                {
+                    if(!(candidates & (1 << k)))
+                        continue;
+
+                    int other = j + k;
 
-                    // Check if other collision object is still valid.
-                    if(!m_entitySystem->IsHandleValid(other->entity) || !other->collision->IsEnabled())
+                    // Reversed objects collide with objects they don't intersect.
+                    bool intersects = (hits & (1 << k)) != 0;
+
+                    // Test exact shapes at current positions if swept bounding boxes intersect.
+                    if(intersects && (!IsSimple(object) || !IsSimple(m_objects[other])))
                     {
-                        other->enabled = false;
+                        intersects = IntersectShapes(object, m_objects[other]);
                     }
 
-                    // Check if this collision object is still valid.
-                    if(!m_entitySystem->IsHandleValid(it->entity) || !it->collision->IsEnabled())
+                    if(!intersects)
                     {
-                        it->enabled = false;
-
-                        // No point in checking further collisions against this objects.
-                        break;
+                        contacts.push_back(std::make_pair(i, other));
                     }
                 }
             }
         }
+    });
+
+    // Dispatch collision events on the main thread in the order of collision objects.
+    // Contacts are sorted so the order doesn't depend on how tests were split between threads.
+    std::sort(m_contacts.begin(), m_contacts.end());
+
+    for(auto it = m_contacts.begin(); it != m_contacts.end(); ++it)
+    {
+        CollisionObject& object = m_objects[it->first];
+        CollisionObject& other = m_objects[it->second];
+
+        // Check if collision objects are still enabled.
+        if(!object.enabled || !other.enabled)
+            continue;
+
+        // Check if collision response with other entity has been disabled.
+        EntityPair pair = { object.entity, other.entity };
+
+        if(m_disabled.Contains(pair))
+            continue;
+
+        // Dispatch an entity collision event.
+        {
+            GameEvent::EntityCollision event(object, other);
+            m_eventSystem->Dispatch(event);
+        }
+
+        // Gather the contact for a batched collision event.
+        m_dispatched.push_back(std::make_pair(&object, &other));
+
+        // Check if other collision object is still valid.
+        // Entities killed by a collision stop colliding at once, even though
+        // they are destroyed only after queued damage events are flushed.
+        if(!m_healthSystem->IsAlive(other.entity) || !other.collision->IsEnabled())
+        {
+            other.enabled = false;
+        }
+
+        // Check if this collision object is still valid.
+        // No point in checking further collisions against it otherwise.
+        if(!m_healthSystem->IsAlive(object.entity) || !object.collision->IsEnabled())
+        {
+            object.enabled = false;
+        }
     }
 
-    // Clear intermediate collision object list.
+    // Dispatch all collisions of the frame at once.
+    // This happens after every single collision event has been dispatched.
+    if(!m_dispatched.empty())
+    {
+        GameEvent::EntityCollisionBatch event(m_dispatched);
+        m_eventSystem->Dispatch(event);
+    }
+
+    // Clear intermediate collision object lists.
     m_objects.clear();
+    m_entities.clear();
+    m_boxes.Clear();
+    m_pairs.clear();
+    m_contacts.clear();
+    m_dispatched.clear();
 }
 
-void CollisionSystem::DisableCollisionResponse(EntityHandle sourceEntity, EntityHandle targetEntity, float duration)
+bool CollisionSystem::TestContact(const CollisionObject& object, const CollisionObject& other) const
 {
-    assert(m_initialized);
+    // Reversed objects are tested against all objects separately.
+    if(object.collision->GetFlags() & CollisionFlags::Reversed)
+        return false;
 
-    // Check if this pair is already disabled.
-    EntityPair pair = { sourceEntity, targetEntity };
-    auto it = m_disabled.find(pair);
+    // Check if an object can collide with the other one.
+    if(!(object.collision->GetMask() & other.collision->GetType()))
+        return false;
+
+    // Test paths of fast moving objects using their swept shapes.
+    if(IsFastMoving(object) || IsFastMoving(other))
+        return IntersectSwept(object, other);
+
+    // Check if objects physically collide.
+    return IntersectShapes(object, other);
+}
+
+void CollisionSystem::RunBatches(int count, int batchSize, JobSystem* jobSystem, const BatchFunction& function)
+{
+    if(count <= 0)
+        return;
 
-    if(it != m_disabled.end())
+    // Process everything in a single batch if running serially.
+    if(jobSystem == nullptr)
     {
-        // Update the duration.
-        float& time = it->second;
+        batchSize = count;
+    }
 
-        if(time < duration)
-        {
-            time = duration;
-        }
+    // Prepare a separate output buffer for each batch.
+    int batchCount = (count + batchSize - 1) / batchSize;
+
+    if((int)m_batches.size() < batchCount)
+    {
+        m_batches.resize(batchCount);
+    }
+
+    // Process batches.
+    auto ProcessBatch = [&](int begin, int end)
+    {
+        PairList& contacts = m_batches[begin / batchSize];
+        contacts.clear();
+
+        function(begin, end, contacts);
+    };
+
+    if(jobSystem != nullptr)
+    {
+        jobSystem->ParallelFor(0, count, batchSize, ProcessBatch);
     }
     else
     {
-        // Insert a new pair.
-        m_disabled.emplace(std::make_pair(pair, duration));
+        ProcessBatch(0, count);
     }
+
+    // Merge batch outputs in order.
+    for(int i = 0; i < batchCount; ++i)
+    {
+        m_contacts.insert(m_contacts.end(), m_batches[i].begin(), m_batches[i].end());
+    }
+}
+
+void CollisionSystem::DisableCollisionResponse(EntityHandle sourceEntity, EntityHandle targetEntity, float duration)
+{
+    assert(m_initialized);
+
+    // Disable the pair or extend its duration.
+    EntityPair pair = { sourceEntity, targetEntity };
+    m_disabled.Insert(pair, duration);
 }
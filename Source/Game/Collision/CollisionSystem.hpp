@@ -2,14 +2,20 @@
 
 #include "Precompiled.hpp"
 #include "CollisionObject.hpp"
+#include "CollisionBroadPhase.hpp"
+#include "CollisionPairTable.hpp"
+#include "BoundingBoxBatch.hpp"
 
 #include "Game/Entity/EntityHandle.hpp"
+#include "Game/Entity/EntitySystem.hpp"
+#include "Game/Event/EventDefinitions.hpp"
 
 // Forward declarations.
 class Services;
 class EventSystem;
-class EntitySystem;
 class ComponentSystem;
+class HealthSystem;
+class JobSystem;
 
 //
 // Collision System
@@ -23,8 +29,14 @@ public:
 
     // Type declarations.
     typedef std::vector<CollisionObject> ObjectList;
-    typedef std::pair<EntityHandle, EntityHandle> EntityPair;
-    typedef std::unordered_multimap<EntityPair, float> DisabledList;
+    typedef std::vector<EntityHandle> EntityList;
+    typedef CollisionBroadPhase::ObjectPair ObjectPair;
+    typedef CollisionBroadPhase::PairList PairList;
+    typedef std::vector<PairList> BatchList;
+    typedef std::function<void(int, int, PairList&)> BatchFunction;
+    typedef std::unique_ptr<CollisionBroadPhase> BroadPhasePtr;
+    typedef CollisionPairTable::EntityPair EntityPair;
+    typedef GameEvent::EntityCollisionBatch::ContactList ContactList;
 
 public:
     CollisionSystem();
@@ -38,6 +50,14 @@ public:
     // Consider using collision masks if you want to disable collisions permanently.
     void DisableCollisionResponse(EntityHandle sourceEntity, EntityHandle targetEntity, float duration = Permanent);
 
+private:
+    // Checks if a regular object generates a collision event with the other one.
+    bool TestContact(const CollisionObject& object, const CollisionObject& other) const;
+
+    // Splits a range into batches that write contacts to separate buffers.
+    // Runs batches in parallel if a job system is provided.
+    void RunBatches(int count, int batchSize, JobSystem* jobSystem, const BatchFunction& function);
+
 private:
     // System state.
     bool m_initialized;
@@ -46,10 +66,29 @@ private:
     EventSystem*     m_eventSystem;
     EntitySystem*    m_entitySystem;
     ComponentSystem* m_componentSystem;
+    HealthSystem*    m_healthSystem;
 
     // Intermediate collision objects.
     ObjectList m_objects;
+    BoundingBoxBatch m_boxes;
+
+    // Entities of collision objects and their validity.
+    EntityList m_entities;
+    EntitySystem::ValidityMask m_validity;
+
+    // Broad phase collision detection.
+    BroadPhasePtr m_broadPhase;
+
+    // Potentially colliding object pairs.
+    PairList m_pairs;
+
+    // Object pairs that generate collision events.
+    PairList m_contacts;
+    BatchList m_batches;
+
+    // Contacts that have been dispatched during the frame.
+    ContactList m_dispatched;
 
     // Disabled collision responses.
-    DisabledList m_disabled;
+    CollisionPairTable m_disabled;
 };
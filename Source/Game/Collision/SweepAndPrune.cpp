@@ -0,0 +1,135 @@
+#include "Precompiled.hpp"
+#include "SweepAndPrune.hpp"
+#include "CollisionComponent.hpp"
+
+#include "Common/JobSystem.hpp"
+
+namespace
+{
+    // Number of objects swept by a single job.
+    const int SweepBatchSize = 256;
+}
+
+SweepAndPrune::SweepAndPrune()
+{
+}
+
+SweepAndPrune::~SweepAndPrune()
+{
+    Cleanup();
+}
+
+void SweepAndPrune::Cleanup()
+{
+    ClearContainer(m_order);
+    ClearContainer(m_types);
+    ClearContainer(m_masks);
+    m_boxes.Cleanup();
+    ClearContainer(m_batches);
+}
+
+void SweepAndPrune::FindPairs(const ObjectList& objects, PairList& pairs, JobSystem* jobSystem)
+{
+    // Sort objects by their minimum horizontal extent.
+    m_order.resize(objects.size());
+
+    for(unsigned int i = 0; i < objects.size(); ++i)
+    {
+        m_order[i] = i;
+    }
+
+    std::sort(m_order.begin(), m_order.end(), [&objects](int a, int b)
+    {
+        return objects[a].sweptAABB.x < objects[b].sweptAABB.x;
+    });
+
+    // Copy bounding boxes and collision bits in sorted order.
+    int count = (int)m_order.size();
+
+    if(count == 0)
+        return;
+
+    m_boxes.Clear();
+    m_types.resize(count);
+    m_masks.resize(count);
+
+    for(int i = 0; i < count; ++i)
+    {
+        const CollisionObject& object = objects[m_order[i]];
+
+        m_boxes.Add(object.sweptAABB);
+        m_types[i] = object.collision->GetType();
+        m_masks[i] = object.collision->GetMask();
+    }
+
+    m_boxes.Finalize();
+
+    // Process everything in a single batch if running serially.
+
+    int batchSize = jobSystem != nullptr ? SweepBatchSize : count;
+    int batchCount = (count + batchSize - 1) / batchSize;
+
+    if((int)m_batches.size() < batchCount)
+    {
+        m_batches.resize(batchCount);
+    }
+
+    // Sweep along the horizontal axis.
+    auto Sweep = [&](int begin, int end)
+    {
+        PairList& batch = m_batches[begin / batchSize];
+        batch.clear();
+
+        for(int a = begin; a < end; ++a)
+        {
+            glm::vec4 box = m_boxes.GetBox(a);
+
+            for(int b = a + 1; b < count; b += BoundingBoxBatch::Width)
+            {
+                // Check which following objects can collide with this one
+                // before testing their bounding boxes.
+                uint32_t candidates = 0;
+                int width = std::min<int>(BoundingBoxBatch::Width, count - b);
+
+                for(int i = 0; i < width; ++i)
+                {
+                    if((m_masks[a] & m_types[b + i]) || (m_masks[b + i] & m_types[a]))
+                    {
+                        candidates |= 1 << i;
+                    }
+                }
+
+                // Test against a few following objects at once.
+                uint32_t hits = candidates != 0 ? m_boxes.Intersect(box, b) & candidates : 0;
+
+                for(int i = 0; hits != 0; ++i, hits >>= 1)
+                {
+                    if(!(hits & 1))
+                        continue;
+
+                    // Add a pair with the lower index first.
+                    batch.push_back(std::minmax(m_order[a], m_order[b + i]));
+                }
+
+                // Stop when following objects begin past the end of this one.
+                if(m_boxes.GetMinX(b + BoundingBoxBatch::Width - 1) > box.z)
+                    break;
+            }
+        }
+    };
+
+    if(jobSystem != nullptr)
+    {
+        jobSystem->ParallelFor(0, count, batchSize, Sweep);
+    }
+    else
+    {
+        Sweep(0, count);
+    }
+
+    // Merge batches in order.
+    for(int i = 0; i < batchCount; ++i)
+    {
+        pairs.insert(pairs.end(), m_batches[i].begin(), m_batches[i].end());
+    }
+}
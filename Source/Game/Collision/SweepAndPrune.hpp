@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Precompiled.hpp"
+#include "CollisionBroadPhase.hpp"
+#include "BoundingBoxBatch.hpp"
+
+//
+// Sweep And Prune
+//  Sorts objects along the horizontal axis and only tests objects
+//  with overlapping horizontal extents against each other. The sweep
+//  can be split between worker threads and pairs are always reported
+//  in the same order.
+//
+
+class SweepAndPrune : public CollisionBroadPhase
+{
+public:
+    // Type declarations.
+    typedef std::vector<int> IndexList;
+    typedef std::vector<uint32_t> BitFieldList;
+    typedef std::vector<PairList> BatchList;
+
+public:
+    SweepAndPrune();
+    ~SweepAndPrune();
+
+    void Cleanup();
+
+    void FindPairs(const ObjectList& objects, PairList& pairs, JobSystem* jobSystem);
+
+private:
+    // Object indices sorted by their minimum horizontal extent.
+    IndexList m_order;
+
+    // Bounding boxes and collision bits in sorted order.
+    BoundingBoxBatch m_boxes;
+    BitFieldList m_types;
+    BitFieldList m_masks;
+
+    // Pairs found by each batch of objects.
+    BatchList m_batches;
+};
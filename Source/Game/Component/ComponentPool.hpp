@@ -11,8 +11,16 @@
 
 class ComponentPoolInterface
 {
+public:
+    // Special values.
+    enum
+    {
+        InvalidIndex = -1,
+    };
+
 protected:
-    ComponentPoolInterface()
+    ComponentPoolInterface() :
+        m_signature(0)
     {
     }
 
@@ -22,10 +30,35 @@ public:
     }
 
     virtual void Remove(EntityHandle handle) = 0;
+    virtual void Clear() = 0;
+
+    void SetSignature(uint32_t signature)
+    {
+        m_signature = signature;
+    }
+
+    uint32_t GetSignature() const
+    {
+        return m_signature;
+    }
+
+private:
+    // Bit identifying the pool in entity component signatures.
+    uint32_t m_signature;
 };
 
 //
 // Component Pool
+//  Sparse set of components indexed by entity handle identifiers.
+//  Components are stored in slots of fixed size pages, so iteration is
+//  linear in memory and components never move when others are created
+//  or removed. Removed components leave free slots that are reused by
+//  new components. Free slots are visited by iterators with an invalid
+//  entity handle.
+//
+//  Debug builds can check if a raw component pointer still refers to
+//  a slot allocated for the same entity, to catch use of components
+//  that were removed or whose slot has been reused since.
 //
 
 template<typename Type>
@@ -36,11 +69,76 @@ public:
     static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
 
     // Type declarations.
-    typedef std::unordered_map<EntityHandle, Type> ComponentList;
-    typedef typename ComponentList::iterator       ComponentIterator;
+    typedef std::pair<EntityHandle, Type> ComponentEntry;
+    typedef std::unique_ptr<ComponentEntry[]> ComponentPage;
+    typedef std::vector<ComponentPage> ComponentPageList;
+    typedef std::vector<int> ComponentIndexList;
+
+    // Component iterator.
+    class ComponentIterator
+    {
+    public:
+        ComponentIterator() :
+            m_pool(nullptr),
+            m_index(0)
+        {
+        }
+
+        ComponentIterator(ComponentPool<Type>* pool, int index) :
+            m_pool(pool),
+            m_index(index)
+        {
+        }
+
+        ComponentEntry& operator*() const
+        {
+            assert(m_pool != nullptr);
+            return m_pool->At(m_index);
+        }
+
+        ComponentEntry* operator->() const
+        {
+            assert(m_pool != nullptr);
+            return &m_pool->At(m_index);
+        }
+
+        ComponentIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        bool operator==(const ComponentIterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        bool operator!=(const ComponentIterator& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+    private:
+        // Iterated pool.
+        ComponentPool<Type>* m_pool;
+
+        // Slot index of the current component.
+        // Indices stay valid when pages are added during iteration.
+        int m_index;
+    };
+
+private:
+    // Constant variables.
+    enum
+    {
+        PageBytes = 16 * 1024,
+        PageSize = PageBytes / sizeof(ComponentEntry) > 0 ? PageBytes / sizeof(ComponentEntry) : 1,
+    };
 
 public:
-    ComponentPool()
+    ComponentPool() :
+        m_size(0),
+        m_count(0)
     {
     }
 
@@ -52,60 +150,230 @@ public:
     void Cleanup()
     {
         // Free component memory.
-        ClearContainer(m_components);
+        ClearContainer(m_pages);
+        ClearContainer(m_indices);
+        ClearContainer(m_freeSlots);
+
+        m_size = 0;
+        m_count = 0;
     }
 
     Type* Create(EntityHandle handle)
     {
-        // Create a new component for this entity handle.
-        auto result = m_components.emplace(std::make_pair(handle, Type()));
+        assert(handle.identifier > 0);
+
+        // Grow the sparse index list if needed.
+        if(handle.identifier >= (int)m_indices.size())
+        {
+            m_indices.resize(handle.identifier + 1, InvalidIndex);
+        }
 
         // Check if the entity already has this component.
-        if(result.second == false)
-            return nullptr;
-    
+        int& index = m_indices[handle.identifier];
+
+        if(index != InvalidIndex)
+        {
+            // Override a component left by an entity of an older version.
+            ComponentEntry& entry = At(index);
+
+            if(entry.first == handle)
+                return nullptr;
+
+            entry.first = handle;
+            entry.second = Type();
+
+            return &entry.second;
+        }
+
+        if(!m_freeSlots.empty())
+        {
+            // Reuse the most recently freed slot.
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            // Allocate a new page if all are full.
+            if(m_size == (int)m_pages.size() * PageSize)
+            {
+                m_pages.emplace_back(new ComponentEntry[PageSize]);
+            }
+
+            // Append a new slot at the end.
+            index = m_size++;
+        }
+
+        ComponentEntry& entry = At(index);
+        entry.first = handle;
+
+        m_count += 1;
+
         // Return a pointer to a newly created component.
-        return &result.first->second;
+        return &entry.second;
+    }
+
+    void Reserve(int count)
+    {
+        assert(count >= 0);
+
+        // Allocate pages for additional components up front.
+        int required = m_size + std::max(0, count - (int)m_freeSlots.size());
+
+        while(required > (int)m_pages.size() * PageSize)
+        {
+            m_pages.emplace_back(new ComponentEntry[PageSize]);
+        }
     }
 
     Type* Lookup(EntityHandle handle)
     {
         // Find a component.
-        auto result = m_components.find(handle);
-    
-        if(result == m_components.end())
+        if(handle.identifier <= 0 || handle.identifier >= (int)m_indices.size())
+            return nullptr;
+
+        int index = m_indices[handle.identifier];
+
+        if(index == InvalidIndex)
             return nullptr;
 
         // Make sure handles match.
-        assert(result->first == handle);
+        ComponentEntry& entry = At(index);
+
+        if(entry.first != handle)
+            return nullptr;
 
         // Return a pointer to the component.
-        return &result->second;
+        return &entry.second;
     }
 
     void Remove(EntityHandle handle)
     {
-        // Remove a component.
-        m_components.erase(handle);
+        // Find a component.
+        if(handle.identifier <= 0 || handle.identifier >= (int)m_indices.size())
+            return;
+
+        int index = m_indices[handle.identifier];
+
+        if(index == InvalidIndex)
+            return;
+
+        if(At(index).first != handle)
+            return;
+
+        // Reset the slot to free resources held by the component.
+        FreeSlot(index);
+
+        m_indices[handle.identifier] = InvalidIndex;
+        m_count -= 1;
     }
 
     void Clear()
     {
         // Remove all components.
-        m_components.clear();
+        for(int i = 0; i < m_size; ++i)
+        {
+            ComponentEntry& entry = At(i);
+
+            if(entry.first.identifier > 0)
+            {
+                m_indices[entry.first.identifier] = InvalidIndex;
+            }
+
+            entry = ComponentEntry();
+        }
+
+        m_freeSlots.clear();
+
+        m_size = 0;
+        m_count = 0;
     }
 
     ComponentIterator Begin()
     {
-        return m_components.begin();
+        return ComponentIterator(this, 0);
     }
 
     ComponentIterator End()
     {
-        return m_components.end();
+        return ComponentIterator(this, m_size);
+    }
+
+    int GetIndex(EntityHandle handle) const
+    {
+        // Find a component.
+        if(handle.identifier <= 0 || handle.identifier >= (int)m_indices.size())
+            return InvalidIndex;
+
+        int index = m_indices[handle.identifier];
+
+        if(index == InvalidIndex)
+            return InvalidIndex;
+
+        // Make sure handles match.
+        if(m_pages[index / PageSize][index % PageSize].first != handle)
+            return InvalidIndex;
+
+        return index;
+    }
+
+    EntityHandle GetHandle(int index)
+    {
+        return At(index).first;
+    }
+
+#ifndef NDEBUG
+    bool IsAllocated(const Type* component, EntityHandle handle) const
+    {
+        // Find the slot allocated for the entity.
+        // Free slots and slots reused by other entities have different handles.
+        int index = GetIndex(handle);
+
+        if(index == InvalidIndex)
+            return false;
+
+        // Check if the component pointer refers to that slot.
+        return &m_pages[index / PageSize][index % PageSize].second == component;
+    }
+#endif
+
+    int GetSize() const
+    {
+        return m_size;
+    }
+
+    int GetCount() const
+    {
+        return m_count;
     }
 
 private:
-    // List of components.
-    ComponentList m_components;
+    ComponentEntry& At(int index)
+    {
+        assert(index >= 0 && index < m_size);
+        return m_pages[index / PageSize][index % PageSize];
+    }
+
+    void FreeSlot(int index)
+    {
+        // Reset the slot and add it to the free list.
+        At(index) = ComponentEntry();
+
+        m_freeSlots.push_back(index);
+    }
+
+private:
+    // Pages of component slots.
+    ComponentPageList m_pages;
+
+    // Slot indices of components by entity identifier.
+    ComponentIndexList m_indices;
+
+    // Indices of free slots to be reused.
+    ComponentIndexList m_freeSlots;
+
+    // Number of used slots, including free ones.
+    int m_size;
+
+    // Number of components.
+    int m_count;
 };
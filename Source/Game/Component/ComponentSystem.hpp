@@ -4,13 +4,16 @@
 
 #include "Common/Services.hpp"
 #include "Common/Receiver.hpp"
+#include "Common/TypeId.hpp"
 #include "Game/Component/ComponentPool.hpp"
+#include "Game/Component/ComponentView.hpp"
 #include "Game/Entity/EntitySystem.hpp"
 #include "Game/Event/EventDefinitions.hpp"
 #include "Game/Event/EventSystem.hpp"
 
 //
 // Component System
+//  Pools are found in a flat array indexed by type identifiers.
 //
 
 class ComponentSystem
@@ -18,8 +21,17 @@ class ComponentSystem
 public:
     // Type declarations.
     typedef std::unique_ptr<ComponentPoolInterface> ComponentPoolPtr;
-    typedef std::unordered_map<std::type_index, ComponentPoolPtr> ComponentPoolList;
-    typedef ComponentPoolList::value_type ComponentPoolPair;
+    typedef std::vector<ComponentPoolPtr> ComponentPoolList;
+    typedef std::vector<ComponentPoolInterface*> SignaturePoolList;
+
+    typedef uint32_t ComponentSignature;
+    typedef std::vector<ComponentSignature> ComponentSignatureList;
+
+    // Constant variables.
+    enum
+    {
+        MaximumPools = sizeof(ComponentSignature) * 8,
+    };
 
 public:
     ComponentSystem() :
@@ -38,9 +50,13 @@ public:
         m_eventSystem = nullptr;
         m_entitySystem = nullptr;
 
+        ClearContainer(m_signaturePools);
         ClearContainer(m_pools);
 
-        m_receiverEntityDestroyed.Cleanup();
+        ClearContainer(m_signatures);
+
+        m_receiverEntitiesDestroyed.Cleanup();
+        m_receiverAllEntitiesDestroyed.Cleanup();
     }
 
     bool Initialize(const Services& services)
@@ -59,10 +75,12 @@ public:
         if(m_entitySystem == nullptr) return false;
 
         // Bind event receivers.
-        m_receiverEntityDestroyed.Bind<ComponentSystem, &ComponentSystem::OnEntityDestroyedEvent>(this);
+        m_receiverEntitiesDestroyed.Bind<ComponentSystem, &ComponentSystem::OnEntitiesDestroyedEvent>(this);
+        m_receiverAllEntitiesDestroyed.Bind<ComponentSystem, &ComponentSystem::OnAllEntitiesDestroyedEvent>(this);
 
         // Subscribe event receivers.
-        m_eventSystem->Subscribe<GameEvent::EntityDestroyed>(m_receiverEntityDestroyed);
+        m_eventSystem->Subscribe<GameEvent::EntitiesDestroyed>(m_receiverEntitiesDestroyed);
+        m_eventSystem->Subscribe<GameEvent::AllEntitiesDestroyed>(m_receiverAllEntitiesDestroyed);
 
         // Success!
         return initialized = true;
@@ -77,19 +95,33 @@ public:
         static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
 
         // Check if component type was already declared.
-        auto it = m_pools.find(typeid(Type));
+        int index = TypeId<Type>();
 
-        if(it != m_pools.end())
+        if(index < (int)m_pools.size() && m_pools[index] != nullptr)
             return;
 
+        // Check if there is a free signature bit left.
+        if(m_signaturePools.size() == MaximumPools)
+        {
+            Log() << "Too many component types have been declared.";
+            assert(false);
+            return;
+        }
+
         // Create a component pool instance.
         auto pool = std::make_unique<ComponentPool<Type>>();
 
+        // Assign a signature bit to the pool.
+        pool->SetSignature(1u << m_signaturePools.size());
+        m_signaturePools.push_back(pool.get());
+
         // Add pool to the collection.
-        auto pair = ComponentPoolPair(typeid(Type), std::move(pool));
-        auto result = m_pools.insert(std::move(pair));
+        if(index >= (int)m_pools.size())
+        {
+            m_pools.resize(index + 1);
+        }
 
-        assert(result.second == true);
+        m_pools[index] = std::move(pool);
     }
 
     template<typename Type>
@@ -104,10 +136,40 @@ public:
         if(pool == nullptr)
             return nullptr;
 
+        // Mark the component in the entity signature.
+        AddSignature(handle, pool->GetSignature());
+
         // Create and return the component.
         return pool->Create(handle);
     }
 
+    template<typename Type>
+    void CreateBatch(const EntitySystem::EntityList& entities, std::vector<Type*>& components)
+    {
+        // Validate component type.
+        static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
+
+        // Get the component pool.
+        ComponentPool<Type>* pool = GetComponentPool<Type>();
+
+        if(pool == nullptr)
+        {
+            components.resize(components.size() + entities.size(), nullptr);
+            return;
+        }
+
+        // Allocate memory for all components at once.
+        pool->Reserve((int)entities.size());
+        components.reserve(components.size() + entities.size());
+
+        // Create components.
+        for(const EntityHandle& entity : entities)
+        {
+            AddSignature(entity, pool->GetSignature());
+            components.push_back(pool->Create(entity));
+        }
+    }
+
     template<typename Type>
     Type* Lookup(EntityHandle handle)
     {
@@ -136,10 +198,37 @@ public:
         if(pool == nullptr)
             return;
 
+        // Check if the entity owns a component.
+        // Stale handles must not clear bits of a newer entity.
+        if(pool->GetIndex(handle) == ComponentPoolInterface::InvalidIndex)
+            return;
+
+        // Clear the component from the entity signature.
+        assert(handle.identifier < (int)m_signatures.size());
+        m_signatures[handle.identifier] &= ~pool->GetSignature();
+
         // Remove a component.
         pool->Remove(handle);
     }
 
+#ifndef NDEBUG
+    template<typename Type>
+    bool IsAllocated(const Type* component, EntityHandle handle)
+    {
+        // Validate component type.
+        static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
+
+        // Get the component pool.
+        ComponentPool<Type>* pool = GetComponentPool<Type>();
+
+        if(pool == nullptr)
+            return false;
+
+        // Check if the component pointer refers to a slot allocated for the entity.
+        return pool->IsAllocated(component, handle);
+    }
+#endif
+
     template<typename Type>
     typename ComponentPool<Type>::ComponentIterator Begin()
     {
@@ -172,6 +261,23 @@ public:
         return pool->End();
     }
 
+    template<typename... Types>
+    ComponentView<Types...> View()
+    {
+        // Create a view over pools of all requested types.
+        return ComponentView<Types...>(std::make_tuple(GetComponentPool<Types>()...));
+    }
+
+    template<typename Driver, typename... Types>
+    ComponentView<Types...> OrderedView()
+    {
+        // Find the driving pool among requested types.
+        const std::size_t driver = ComponentTypeIndex<Driver, Types...>::value;
+
+        // Create a view that visits entities in the order of the driving pool.
+        return ComponentView<Types...>(std::make_tuple(GetComponentPool<Types>()...), driver);
+    }
+
     template<typename Type>
     ComponentPool<Type>* GetComponentPool()
     {
@@ -179,35 +285,81 @@ public:
         static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
 
         // Find pool by component type.
-        auto it = m_pools.find(typeid(Type));
+        int index = TypeId<Type>();
 
-        if(it == m_pools.end())
+        if(index >= (int)m_pools.size())
             return nullptr;
 
         // Cast the pointer that we already know is a component pool.
-        ComponentPool<Type>* pool = reinterpret_cast<ComponentPool<Type>*>(it->second.get());
+        ComponentPool<Type>* pool = reinterpret_cast<ComponentPool<Type>*>(m_pools[index].get());
 
         // Return the pool.
         return pool;
     }
 
 private:
-    void OnEntityDestroyedEvent(const GameEvent::EntityDestroyed& event)
+    void AddSignature(EntityHandle handle, ComponentSignature signature)
     {
-        for(auto& pair : m_pools)
+        assert(handle.identifier > 0);
+
+        // Grow the signature list if needed.
+        if(handle.identifier >= (int)m_signatures.size())
         {
-            pair.second->Remove(event.entity);
+            m_signatures.resize(handle.identifier + 1, 0);
+        }
+
+        // Add component bits to the signature.
+        m_signatures[handle.identifier] |= signature;
+    }
+
+    void OnEntitiesDestroyedEvent(const GameEvent::EntitiesDestroyed& event)
+    {
+        // Remove components only from pools that hold them.
+        for(const EntityHandle& entity : event.entities)
+        {
+            if(entity.identifier <= 0 || entity.identifier >= (int)m_signatures.size())
+                continue;
+
+            ComponentSignature signature = m_signatures[entity.identifier];
+
+            for(int i = 0; signature != 0; ++i, signature >>= 1)
+            {
+                if(signature & 1)
+                {
+                    m_signaturePools[i]->Remove(entity);
+                }
+            }
+
+            m_signatures[entity.identifier] = 0;
         }
     }
 
+    void OnAllEntitiesDestroyedEvent(const GameEvent::AllEntitiesDestroyed&)
+    {
+        // Clear whole pools instead of removing components one by one.
+        for(ComponentPoolInterface* pool : m_signaturePools)
+        {
+            pool->Clear();
+        }
+
+        std::fill(m_signatures.begin(), m_signatures.end(), 0);
+    }
+
 private:
     // Game systems.
     EventSystem* m_eventSystem;
     EntitySystem* m_entitySystem;
 
-    // Component pools.
+    // Component pools by type identifier.
     ComponentPoolList m_pools;
 
+    // Component pools by signature bit.
+    SignaturePoolList m_signaturePools;
+
+    // Component signatures by entity identifier.
+    ComponentSignatureList m_signatures;
+
     // Event receivers.
-    Receiver<GameEvent::EntityDestroyed> m_receiverEntityDestroyed;
+    Receiver<GameEvent::EntitiesDestroyed> m_receiverEntitiesDestroyed;
+    Receiver<GameEvent::AllEntitiesDestroyed> m_receiverAllEntitiesDestroyed;
 };
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "Precompiled.hpp"
+#include "ComponentPool.hpp"
+
+#include "Game/Entity/EntityHandle.hpp"
+
+//
+// Component Type Index
+//  Finds the position of a component type in a list at compile time.
+//
+
+template<typename Type, typename... Types>
+struct ComponentTypeIndex;
+
+template<typename Type, typename... Types>
+struct ComponentTypeIndex<Type, Type, Types...> : std::integral_constant<std::size_t, 0>
+{
+};
+
+template<typename Type, typename Other, typename... Types>
+struct ComponentTypeIndex<Type, Other, Types...> : std::integral_constant<std::size_t, 1 + ComponentTypeIndex<Type, Types...>::value>
+{
+};
+
+//
+// Component View Helper
+//  Unrolls operations over every pool of a view at compile time.
+//
+
+template<std::size_t Index, std::size_t Count>
+struct ComponentViewHelper
+{
+    template<typename PoolList>
+    static bool IsValid(const PoolList& pools)
+    {
+        if(std::get<Index>(pools) == nullptr)
+            return false;
+
+        return ComponentViewHelper<Index + 1, Count>::IsValid(pools);
+    }
+
+    template<typename PoolList>
+    static std::size_t Smallest(const PoolList& pools, std::size_t smallest, int count)
+    {
+        if(std::get<Index>(pools)->GetCount() < count)
+        {
+            smallest = Index;
+            count = std::get<Index>(pools)->GetCount();
+        }
+
+        return ComponentViewHelper<Index + 1, Count>::Smallest(pools, smallest, count);
+    }
+
+    template<typename PoolList>
+    static EntityHandle GetHandle(const PoolList& pools, std::size_t pool, int index)
+    {
+        if(pool == Index)
+            return std::get<Index>(pools)->GetHandle(index);
+
+        return ComponentViewHelper<Index + 1, Count>::GetHandle(pools, pool, index);
+    }
+
+    template<typename PoolList>
+    static int GetSize(const PoolList& pools, std::size_t pool)
+    {
+        if(pool == Index)
+            return std::get<Index>(pools)->GetSize();
+
+        return ComponentViewHelper<Index + 1, Count>::GetSize(pools, pool);
+    }
+
+    template<typename PoolList, typename ComponentList>
+    static bool Lookup(const PoolList& pools, ComponentList& components, EntityHandle entity)
+    {
+        auto component = std::get<Index>(pools)->Lookup(entity);
+
+        if(component == nullptr)
+            return false;
+
+        std::get<Index>(components) = component;
+
+        return ComponentViewHelper<Index + 1, Count>::Lookup(pools, components, entity);
+    }
+};
+
+template<std::size_t Count>
+struct ComponentViewHelper<Count, Count>
+{
+    template<typename PoolList>
+    static bool IsValid(const PoolList&)
+    {
+        return true;
+    }
+
+    template<typename PoolList>
+    static std::size_t Smallest(const PoolList&, std::size_t smallest, int)
+    {
+        return smallest;
+    }
+
+    template<typename PoolList>
+    static EntityHandle GetHandle(const PoolList&, std::size_t, int)
+    {
+        assert(false);
+        return EntityHandle();
+    }
+
+    template<typename PoolList>
+    static int GetSize(const PoolList&, std::size_t)
+    {
+        assert(false);
+        return 0;
+    }
+
+    template<typename PoolList, typename ComponentList>
+    static bool Lookup(const PoolList&, ComponentList&, EntityHandle)
+    {
+        return true;
+    }
+};
+
+//
+// Component View
+//  Iterates over entities that have all of the requested components.
+//  The loop is driven by the smallest pool and the remaining components
+//  are looked up directly by the entity identifier. A view can also be
+//  driven by a chosen pool, to visit entities in the order of that pool.
+//
+//  Example usage:
+//      auto view = componentSystem->View<TransformComponent, RenderComponent>();
+//
+//      for(auto it = view.Begin(); it != view.End(); ++it)
+//      {
+//          TransformComponent& transform = it.Get<TransformComponent>();
+//          RenderComponent& render = it.Get<RenderComponent>();
+//      }
+//
+
+template<typename... Types>
+class ComponentView
+{
+public:
+    // Type declarations.
+    typedef std::tuple<ComponentPool<Types>*...> PoolList;
+    typedef std::tuple<Types*...>                ComponentList;
+    typedef ComponentViewHelper<0, sizeof...(Types)> Helper;
+
+    // View iterator.
+    class Iterator
+    {
+    public:
+        Iterator(const ComponentView<Types...>* view, int index) :
+            m_view(view),
+            m_index(index)
+        {
+            Seek();
+        }
+
+        Iterator& operator++()
+        {
+            ++m_index;
+            Seek();
+
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+        EntityHandle GetEntity() const
+        {
+            return m_entity;
+        }
+
+        template<typename Type>
+        Type& Get() const
+        {
+            return *std::get<Type*>(m_components);
+        }
+
+    private:
+        void Seek()
+        {
+            // Advance until an entity with all components is found.
+            while(m_index < m_view->m_count)
+            {
+                m_entity = Helper::GetHandle(m_view->m_pools, m_view->m_driver, m_index);
+
+                if(Helper::Lookup(m_view->m_pools, m_components, m_entity))
+                    break;
+
+                ++m_index;
+            }
+        }
+
+    private:
+        // Iterated view.
+        const ComponentView<Types...>* m_view;
+
+        // Index in the driving pool.
+        int m_index;
+
+        // Current entity and its components.
+        EntityHandle  m_entity;
+        ComponentList m_components;
+    };
+
+public:
+    ComponentView(const PoolList& pools) :
+        m_pools(pools),
+        m_driver(0),
+        m_count(0)
+    {
+        // View is empty if any of the component types wasn't declared.
+        if(!Helper::IsValid(m_pools))
+            return;
+
+        // Drive iteration from the pool with the least components.
+        m_driver = Helper::Smallest(m_pools, 0, std::numeric_limits<int>::max());
+        m_count = Helper::GetSize(m_pools, m_driver);
+    }
+
+    ComponentView(const PoolList& pools, std::size_t driver) :
+        m_pools(pools),
+        m_driver(driver),
+        m_count(0)
+    {
+        assert(driver < sizeof...(Types));
+
+        // View is empty if any of the component types wasn't declared.
+        if(!Helper::IsValid(m_pools))
+            return;
+
+        // Drive iteration from the chosen pool.
+        m_count = Helper::GetSize(m_pools, m_driver);
+    }
+
+    Iterator Begin() const
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator End() const
+    {
+        return Iterator(this, m_count);
+    }
+
+private:
+    // Viewed component pools.
+    PoolList m_pools;
+
+    // Pool driving the iteration.
+    std::size_t m_driver;
+
+    // Number of slots in the driving pool.
+    // Components appended during iteration are not visited.
+    int m_count;
+};
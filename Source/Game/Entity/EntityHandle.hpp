@@ -52,8 +52,18 @@ namespace std
     {
         std::size_t operator()(const std::pair<EntityHandle, EntityHandle>& pair) const
         {
-            // Use combined identifiers as a hash.
-            return pair.first.identifier * std::numeric_limits<int>::max() + pair.second.identifier;
+            // Combine identifiers and versions of both handles.
+            uint64_t hash = (uint64_t)(uint32_t)pair.first.identifier << 32 | (uint32_t)pair.second.identifier;
+            hash ^= (uint64_t)(uint32_t)(pair.first.version ^ pair.second.version << 16) * 0x9E3779B97F4A7C15ull;
+
+            // Mix bits so close identifiers don't cluster.
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ull;
+            hash ^= hash >> 33;
+
+            return (std::size_t)hash;
         }
     };
 }
@@ -9,7 +9,6 @@ namespace
 {
     // Constant variables.
     const int MaximumIdentifier   = std::numeric_limits<int>::max();
-    const int InvalidIdentifier   = 0;
     const int InvalidNextFree     = -1;
     const int InvalidQueueElement = -1;
 }
@@ -35,11 +34,15 @@ void EntitySystem::Cleanup()
     ProcessCommands();
 
     ClearContainer(m_commands);
+    ClearContainer(m_created);
+    ClearContainer(m_destroyed);
 
     // Destroy all entities.
     DestroyAllEntities();
 
-    ClearContainer(m_handles);
+    ClearContainer(m_versions);
+    ClearContainer(m_flags);
+    ClearContainer(m_nextFree);
 
     // System state.
     m_initialized = false;
@@ -76,26 +79,18 @@ EntityHandle EntitySystem::CreateEntity()
     assert(m_initialized);
 
     // Check if we reached the numerical limits.
-    assert(m_handles.size() != MaximumIdentifier);
+    assert(m_flags.size() != MaximumIdentifier);
 
     // Create a new handle if the free list queue is empty.
     if(m_freeListEmpty)
     {
-        // Create an entity handle.
-        EntityHandle handle;
-        handle.identifier = m_handles.size() + 1;
-        handle.version = 0;
-
         // Create a handle entry.
-        HandleEntry entry;
-        entry.handle = handle;
-        entry.nextFree = InvalidNextFree;
-        entry.flags = HandleFlags::Free;
-
-        m_handles.push_back(entry);
+        m_versions.push_back(0);
+        m_flags.push_back(HandleFlags::None);
+        m_nextFree.push_back(InvalidNextFree);
 
         // Add new handle entry to the free list queue.
-        int handleIndex = m_handles.size() - 1;
+        int handleIndex = m_flags.size() - 1;
 
         m_freeListDequeue = handleIndex;
         m_freeListEnqueue = handleIndex;
@@ -104,7 +99,6 @@ EntityHandle EntitySystem::CreateEntity()
 
     // Retrieve an unused handle from the free list.
     int handleIndex = m_freeListDequeue;
-    HandleEntry& handleEntry = m_handles[handleIndex];
 
     // Update the free list queue.
     if(m_freeListDequeue == m_freeListEnqueue)
@@ -119,23 +113,44 @@ EntityHandle EntitySystem::CreateEntity()
     {
         // If there were more than a single element in the queue.
         // Set the beginning of the queue to the next free element.
-        m_freeListDequeue = handleEntry.nextFree;
+        m_freeListDequeue = m_nextFree[handleIndex];
     }
 
-    handleEntry.nextFree = InvalidNextFree;
+    m_nextFree[handleIndex] = InvalidNextFree;
 
     // Mark handle as valid.
-    handleEntry.flags |= HandleFlags::Valid;
+    m_flags[handleIndex] |= HandleFlags::Valid;
+
+    // Create an entity handle.
+    EntityHandle handle;
+    handle.identifier = handleIndex + 1;
+    handle.version = m_versions[handleIndex];
 
     // Add a create entity commands.
     EntityCommand command;
     command.type = EntityCommands::Create;
-    command.handle = handleEntry.handle;
+    command.handle = handle;
     
     m_commands.push_back(command);
 
     // Return the handle.
-    return handleEntry.handle;
+    return handle;
+}
+
+void EntitySystem::CreateEntities(int count, EntityList& entities)
+{
+    assert(m_initialized);
+    assert(count >= 0);
+
+    // Allocate space for all entities at once.
+    entities.reserve(entities.size() + count);
+    m_commands.reserve(m_commands.size() + count);
+
+    // Create entities.
+    for(int i = 0; i < count; ++i)
+    {
+        entities.push_back(CreateEntity());
+    }
 }
 
 void EntitySystem::DestroyEntity(const EntityHandle& entity)
@@ -148,19 +163,32 @@ void EntitySystem::DestroyEntity(const EntityHandle& entity)
 
     // Locate the handle entry.
     int handleIndex = entity.identifier - 1;
-    HandleEntry& handleEntry = m_handles[handleIndex];
 
     // Set the handle destroy flag.
-    handleEntry.flags |= HandleFlags::Destroy;
+    m_flags[handleIndex] |= HandleFlags::Destroy;
 
     // Add a destroy entity command.
     EntityCommand command;
     command.type = EntityCommands::Destroy;
-    command.handle = handleEntry.handle;
+    command.handle = entity;
 
     m_commands.push_back(command);
 }
 
+void EntitySystem::DestroyEntities(const EntityList& entities)
+{
+    assert(m_initialized);
+
+    // Allocate space for all commands at once.
+    m_commands.reserve(m_commands.size() + entities.size());
+
+    // Destroy entities.
+    for(const EntityHandle& entity : entities)
+    {
+        DestroyEntity(entity);
+    }
+}
+
 void EntitySystem::DestroyAllEntities()
 {
     if(!m_initialized)
@@ -170,37 +198,41 @@ void EntitySystem::DestroyAllEntities()
     ProcessCommands();
 
     // Check if there are any entities to destroy.
-    if(m_handles.empty())
+    if(m_flags.empty())
         return;
 
-    // Inform about entities soon to be destroyed.
-    for(auto it = m_handles.begin(); it != m_handles.end(); ++it)
+    // Send a single event about all entities soon to be destroyed,
+    // so receivers can drop their data in bulk.
+    if(m_entityCount > 0)
     {
-        HandleEntry& handleEntry = *it;
+        m_eventSystem->Dispatch(GameEvent::AllEntitiesDestroyed());
+    }
 
-        if(handleEntry.flags & HandleFlags::Valid)
+    // Free handles of destroyed entities.
+    for(unsigned int i = 0; i < m_flags.size(); ++i)
+    {
+        if(m_flags[i] & HandleFlags::Valid)
         {
-            // Send event about soon to be destroyed entity.
-            m_eventSystem->Dispatch(GameEvent::EntityDestroyed(handleEntry.handle));
-
             // Set the handle free flags.
-            handleEntry.flags = HandleFlags::Free;
+            m_flags[i] = HandleFlags::Free;
 
             // Increment the handle version to invalidate it.
-            handleEntry.handle.version += 1;
+            m_versions[i] += 1;
         }
     }
 
+    // Reset the counter of active entities.
+    m_entityCount = 0;
+
     // Chain handles for the free list.
-    for(unsigned int i = 0; i < m_handles.size(); ++i)
+    for(unsigned int i = 0; i < m_nextFree.size(); ++i)
     {
-        HandleEntry& handleEntry = m_handles[i];
-        handleEntry.nextFree = i + 1;
+        m_nextFree[i] = i + 1;
     }
 
     // Close the free list queue chain at the end.
-    int lastHandleIndex = m_handles.size() - 1;
-    m_handles[lastHandleIndex].nextFree = InvalidNextFree;
+    int lastHandleIndex = m_nextFree.size() - 1;
+    m_nextFree[lastHandleIndex] = InvalidNextFree;
 
     // Set the free list variables.
     m_freeListDequeue = 0;
@@ -208,34 +240,41 @@ void EntitySystem::DestroyAllEntities()
     m_freeListEmpty = false;
 }
 
-bool EntitySystem::IsHandleValid(const EntityHandle& entity) const
+void EntitySystem::ValidateHandles(const EntityHandle* entities, int count, ValidityMask& mask) const
 {
     assert(m_initialized);
+    assert(entities != nullptr || count == 0);
 
-    // Check if the handle identifier is valid.
-    if(entity.identifier <= InvalidIdentifier)
-        return false;
+    // Resize the mask to fit a bit for every handle.
+    int wordCount = (count + 31) / 32;
+    mask.resize(wordCount);
 
-    if(entity.identifier > (int)m_handles.size())
-        return false;
+    // Check handles against the table one word of bits at a time.
+    unsigned int handleCount = m_flags.size();
 
-    // Locate the handle entry.
-    int handleIndex = entity.identifier - 1;
-    const HandleEntry& handleEntry = m_handles[handleIndex];
+    for(int word = 0; word < wordCount; ++word)
+    {
+        int begin = word * 32;
+        int end = std::min(begin + 32, count);
+
+        uint32_t bits = 0;
+
+        for(int i = begin; i < end; ++i)
+        {
+            const EntityHandle& entity = entities[i];
 
-    // Check if handle is valid.
-    if(!(handleEntry.flags & HandleFlags::Valid))
-        return false;
+            // Same checks as in IsHandleValid().
+            unsigned int handleIndex = (unsigned int)entity.identifier - 1;
 
-    // Check if handle is scheduled to be destroyed.
-    if(handleEntry.flags & HandleFlags::Destroy)
-        return false;
+            bool valid = handleIndex < handleCount
+                && (m_flags[handleIndex] & (HandleFlags::Valid | HandleFlags::Destroy)) == HandleFlags::Valid
+                && m_versions[handleIndex] == entity.version;
 
-    // Check if the handle versions match.
-    if(handleEntry.handle.version != entity.version)
-        return false;
+            bits |= (uint32_t)valid << (i - begin);
+        }
 
-    return true;
+        mask[word] = bits;
+    }
 }
 
 void EntitySystem::ProcessCommands()
@@ -252,21 +291,20 @@ void EntitySystem::ProcessCommands()
             {
                 // Locate the handle entry.
                 int handleIndex = command->handle.identifier - 1;
-                HandleEntry& handleEntry = m_handles[handleIndex];
 
                 // Make sure handles match.
-                assert(command->handle == handleEntry.handle);
+                assert(command->handle.version == m_versions[handleIndex]);
 
                 // Mark handle as active.
-                assert(!(handleEntry.flags & HandleFlags::Active));
+                assert(!(m_flags[handleIndex] & HandleFlags::Active));
 
-                handleEntry.flags |= HandleFlags::Active;
+                m_flags[handleIndex] |= HandleFlags::Active;
 
                 // Increment the counter of active entities.
                 m_entityCount += 1;
 
-                // Send event about created entity.
-                m_eventSystem->Dispatch(GameEvent::EntityCreated(handleEntry.handle));
+                // Add entity to the list of created entities.
+                m_created.push_back(command->handle);
             }
             break;
 
@@ -274,57 +312,78 @@ void EntitySystem::ProcessCommands()
             {
                 // Locate the handle entry.
                 int handleIndex = command->handle.identifier - 1;
-                HandleEntry& handleEntry = m_handles[handleIndex];
 
                 // Check if handles match.
-                if(command->handle != handleEntry.handle)
+                if(command->handle.version != m_versions[handleIndex])
                 {
                     // Trying to destroy an entity twice.
                     assert(false);
                     continue;
                 }
 
-                // Send event about soon to be destroyed entity.
-                m_eventSystem->Dispatch(GameEvent::EntityDestroyed(handleEntry.handle));
+                // Add entity to the list of destroyed entities.
+                m_destroyed.push_back(command->handle);
+            }
+            break;
+        }
+    }
 
-                // Decrement the counter of active entities.
-                m_entityCount -= 1;
+    // Clear processed entity commands.
+    // Commands added by event receivers will be processed next time.
+    m_commands.clear();
 
-                // Mark handle flags as free
-                assert(handleEntry.flags & HandleFlags::Valid);
-                assert(handleEntry.flags & HandleFlags::Active);
-                assert(handleEntry.flags & HandleFlags::Destroy);
+    // Send event about created entities.
+    if(!m_created.empty())
+    {
+        m_eventSystem->Dispatch(GameEvent::EntitiesCreated(m_created));
+        m_created.clear();
+    }
 
-                handleEntry.flags = HandleFlags::Free;
+    // Send event about soon to be destroyed entities.
+    if(!m_destroyed.empty())
+    {
+        m_eventSystem->Dispatch(GameEvent::EntitiesDestroyed(m_destroyed));
+    }
 
-                // Increment the handle version to invalidate it.
-                handleEntry.handle.version += 1;
+    // Free handles of destroyed entities.
+    for(const EntityHandle& handle : m_destroyed)
+    {
+        int handleIndex = handle.identifier - 1;
 
-                // Add the handle entry to the free list queue.
-                if(m_freeListEmpty)
-                {
-                    // If there are no elements in the queue.
-                    // Set the element as the only one in the queue.
-                    m_freeListDequeue = handleIndex;
-                    m_freeListEnqueue = handleIndex;
-                    m_freeListEmpty = false;
-                }
-                else
-                {
-                    assert(m_handles[m_freeListEnqueue].nextFree == InvalidNextFree);
+        // Decrement the counter of active entities.
+        m_entityCount -= 1;
 
-                    // If there are already other elements in the queue.
-                    // Add the element to the end of the queue chain.
-                    m_handles[m_freeListEnqueue].nextFree = handleIndex;
-                    m_freeListEnqueue = handleIndex;
-                }
-            }
-            break;
+        // Mark handle flags as free
+        assert(m_flags[handleIndex] & HandleFlags::Valid);
+        assert(m_flags[handleIndex] & HandleFlags::Active);
+        assert(m_flags[handleIndex] & HandleFlags::Destroy);
+
+        m_flags[handleIndex] = HandleFlags::Free;
+
+        // Increment the handle version to invalidate it.
+        m_versions[handleIndex] += 1;
+
+        // Add the handle entry to the free list queue.
+        if(m_freeListEmpty)
+        {
+            // If there are no elements in the queue.
+            // Set the element as the only one in the queue.
+            m_freeListDequeue = handleIndex;
+            m_freeListEnqueue = handleIndex;
+            m_freeListEmpty = false;
+        }
+        else
+        {
+            assert(m_nextFree[m_freeListEnqueue] == InvalidNextFree);
+
+            // If there are already other elements in the queue.
+            // Add the element to the end of the queue chain.
+            m_nextFree[m_freeListEnqueue] = handleIndex;
+            m_freeListEnqueue = handleIndex;
         }
     }
 
-    // Clear processed entity commands.
-    m_commands.clear();
+    m_destroyed.clear();
 }
 
 unsigned int EntitySystem::GetEntityCount() const
@@ -35,14 +35,6 @@ public:
         static const uint32_t Free = None; 
     };
 
-    // Handle entry structure.
-    struct HandleEntry
-    {
-        EntityHandle handle;
-        int          nextFree;
-        uint32_t     flags;
-    };
-
     // Entity commands.
     struct EntityCommands
     {
@@ -61,10 +53,15 @@ public:
         EntityHandle handle;
     };
 
-private:
     // Type declarations.
-    typedef std::vector<HandleEntry>       HandleList;
-    typedef std::vector<EntityCommand>     CommandList;
+    typedef std::vector<EntityHandle> EntityList;
+    typedef std::vector<uint32_t> ValidityMask;
+
+private:
+    typedef std::vector<int>           VersionList;
+    typedef std::vector<uint32_t>      FlagList;
+    typedef std::vector<int>           FreeList;
+    typedef std::vector<EntityCommand> CommandList;
 
 public:
     EntitySystem();
@@ -79,14 +76,61 @@ public:
     // Creates an entity.
     EntityHandle CreateEntity();
 
+    // Creates a number of entities and appends their handles to the list.
+    void CreateEntities(int count, EntityList& entities);
+
     // Destroys an entity.
     void DestroyEntity(const EntityHandle& entity);
 
-    // Destroys all entities.
+    // Destroys a list of entities.
+    void DestroyEntities(const EntityList& entities);
+
+    // Destroys all entities at once without sending per entity events.
     void DestroyAllEntities();
 
     // Checks if an entity handle is valid.
-    bool IsHandleValid(const EntityHandle& entity) const;
+    bool IsHandleValid(const EntityHandle& entity) const
+    {
+        assert(m_initialized);
+
+        // Identifiers out of range wrap around to indices past the end.
+        unsigned int handleIndex = (unsigned int)entity.identifier - 1;
+
+        if(handleIndex >= m_flags.size())
+            return false;
+
+        // Check if handle is valid, not scheduled to be destroyed and versions match.
+        return (m_flags[handleIndex] & (HandleFlags::Valid | HandleFlags::Destroy)) == HandleFlags::Valid
+            && m_versions[handleIndex] == entity.version;
+    }
+
+    // Checks if an entity handle is valid and its creation has been processed.
+    bool IsHandleActive(const EntityHandle& entity) const
+    {
+        assert(m_initialized);
+
+        // Identifiers out of range wrap around to indices past the end.
+        unsigned int handleIndex = (unsigned int)entity.identifier - 1;
+
+        if(handleIndex >= m_flags.size())
+            return false;
+
+        // Check if handle is active, not scheduled to be destroyed and versions match.
+        const uint32_t mask = HandleFlags::Valid | HandleFlags::Active | HandleFlags::Destroy;
+
+        return (m_flags[handleIndex] & mask) == (HandleFlags::Valid | HandleFlags::Active)
+            && m_versions[handleIndex] == entity.version;
+    }
+
+    // Checks a list of entity handles at once.
+    // Sets a bit in the mask for every valid handle.
+    void ValidateHandles(const EntityHandle* entities, int count, ValidityMask& mask) const;
+
+    // Checks if a handle has been marked as valid in the mask.
+    static bool IsMaskSet(const ValidityMask& mask, int index)
+    {
+        return (mask[index / 32] >> (index % 32) & 1) != 0;
+    }
 
     // Process entity commands.
     void ProcessCommands();
@@ -104,8 +148,15 @@ private:
     // List of commands.
     CommandList m_commands;
 
-    // List of entities.
-    HandleList m_handles;
+    // Entities processed by commands during the frame.
+    EntityList m_created;
+    EntityList m_destroyed;
+
+    // Entity handle table stored as separate arrays.
+    // Handle identifiers are indices into the arrays plus one.
+    VersionList m_versions;
+    FlagList    m_flags;
+    FreeList    m_nextFree;
 
     // Number of active entities.
     unsigned int m_entityCount;
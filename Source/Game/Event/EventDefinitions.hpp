@@ -4,7 +4,6 @@
 
 #include "Game/Entity/EntityHandle.hpp"
 #include "Game/Collision/CollisionObject.hpp"
-#include "Game/Health/HealthComponent.hpp"
 
 //
 // Game Events
@@ -12,39 +11,45 @@
 
 namespace GameEvent
 {
-    // Called after entity has been just created.
-    struct EntityCreated
+    // Called once per frame after entities have been just created.
+    struct EntitiesCreated
     {
-        EntityCreated(EntityHandle entity) :
-            entity(entity)
+        EntitiesCreated(const std::vector<EntityHandle>& entities) :
+            entities(entities)
         {
         }
 
-        EntityHandle entity;
+        const std::vector<EntityHandle>& entities;
     };
 
-    // Called when entity is just about to be destroyed.
-    struct EntityDestroyed
+    // Called once per frame when entities are just about to be destroyed.
+    struct EntitiesDestroyed
     {
-        EntityDestroyed(EntityHandle entity) :
-            entity(entity)
+        EntitiesDestroyed(const std::vector<EntityHandle>& entities) :
+            entities(entities)
         {
         }
 
-        EntityHandle entity;
+        const std::vector<EntityHandle>& entities;
+    };
+
+    // Called when all entities are just about to be destroyed at once.
+    // Receivers should drop entity data in bulk instead of one by one.
+    struct AllEntitiesDestroyed
+    {
     };
 
     // Called when entity health changes.
+    // Queued events only carry entity handles, receivers
+    // have to look up current components themselves.
     struct EntityHealth
     {
         EntityHealth() :
-            entity(),
-            component(nullptr)
+            entity()
         {
         }
 
         EntityHandle entity;
-        HealthComponent* component;
     };
 
     // Called when entity has been damaged.
@@ -52,14 +57,14 @@ namespace GameEvent
     {
         EntityDamaged() :
             entity(),
-            component(nullptr),
-            value(0)
+            value(0),
+            alive(false)
         {
         }
 
         EntityHandle entity;
-        HealthComponent* component;
         int value;
+        bool alive;
     };
 
     // Called when entity has been healed.
@@ -67,13 +72,11 @@ namespace GameEvent
     {
         EntityHealed() :
             entity(),
-            component(nullptr),
             value(0)
         {
         }
 
         EntityHandle entity;
-        HealthComponent* component;
         int value;
     };
 
@@ -88,4 +91,18 @@ namespace GameEvent
         const CollisionObject& self;
         const CollisionObject& other;
     };
+
+    // Called once per frame with all collisions dispatched during that frame.
+    struct EntityCollisionBatch
+    {
+        typedef std::pair<const CollisionObject*, const CollisionObject*> Contact;
+        typedef std::vector<Contact> ContactList;
+
+        EntityCollisionBatch(const ContactList& contacts) :
+            contacts(contacts)
+        {
+        }
+
+        const ContactList& contacts;
+    };
 }
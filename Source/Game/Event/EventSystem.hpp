@@ -3,17 +3,166 @@
 #include "Precompiled.hpp"
 #include "Common/Dispatcher.hpp"
 #include "Common/Receiver.hpp"
+#include "Common/TypeId.hpp"
+
+// Forward declarations.
+class EventSystem;
+
+//
+// Event Queue Interface
+//
+
+class EventQueueInterface
+{
+protected:
+    EventQueueInterface()
+    {
+    }
+
+public:
+    virtual ~EventQueueInterface()
+    {
+    }
+
+    virtual void Take() = 0;
+    virtual void Flush(EventSystem& eventSystem, int count) = 0;
+};
+
+//
+// Event Queue
+//  Buffer of events of a single type waiting to be flushed.
+//  Pending events are taken before flushing, so events queued
+//  by receivers wait for the next flush. Taken events are sent
+//  in runs, interleaved with runs of other event types.
+//
+
+template<typename Type>
+class EventQueue : public EventQueueInterface
+{
+public:
+    EventQueue() :
+        m_cursor(0)
+    {
+    }
+
+    void Push(const Type& event)
+    {
+        m_pending.push_back(event);
+    }
+
+    void Take()
+    {
+        assert(m_flushing.empty());
+        m_flushing.swap(m_pending);
+        m_cursor = 0;
+    }
+
+    void Flush(EventSystem& eventSystem, int count);
+
+private:
+    // Events waiting to be flushed.
+    std::vector<Type> m_pending;
+
+    // Events being flushed. Kept to reuse memory.
+    std::vector<Type> m_flushing;
+
+    // Index of the next event to be sent.
+    int m_cursor;
+};
+
+//
+// Queued Event
+//  Event queued from another thread, waiting to be moved to its event queue.
+//  Constructed in place in chunks of memory, one after another.
+//
+
+class QueuedEventInterface
+{
+protected:
+    QueuedEventInterface() :
+        size(0)
+    {
+    }
+
+public:
+    virtual ~QueuedEventInterface()
+    {
+    }
+
+    virtual void Store(EventSystem& eventSystem) = 0;
+
+public:
+    // Size of the event in its chunk, including padding.
+    std::size_t size;
+};
+
+template<typename Type>
+class QueuedEvent : public QueuedEventInterface
+{
+public:
+    QueuedEvent(const Type& event) :
+        m_event(event)
+    {
+    }
+
+    void Store(EventSystem& eventSystem);
+
+private:
+    Type m_event;
+};
 
 //
 // Event System
+//  Dispatchers are stored in a flat array indexed by type identifiers.
+//
+//  Events can be dispatched immediately or queued and dispatched later
+//  when the queue is flushed at a defined synchronization point. Queued
+//  events are copied, so they must not refer to temporary data. Events
+//  can be queued from any thread, but are only flushed on the thread
+//  that initialized the event system.
+//
+//  Flushing sends events of all types in the order they were queued.
+//  Consecutively queued events of the same type are sent as a run
+//  through a single dispatcher lookup. Events queued from other threads
+//  are ordered after events queued on the flushing thread since the
+//  last flush. They are written one after another to chunks of memory
+//  that are reused, so queuing them doesn't allocate once enough chunks
+//  exist for a frame of events.
+//
+//  Example usage:
+//      eventSystem.Queue(GameEvent::EntityHealth(/* ... */));
+//      eventSystem.Flush();
 //
 
 class EventSystem
 {
+    template<typename Type>
+    friend class EventQueue;
+
     // Type declarations.
     typedef std::unique_ptr<DispatcherInterface> DispatcherPtr;
-    typedef std::unordered_map<std::type_index, DispatcherPtr> DispatcherList;
-    typedef DispatcherList::value_type DispatcherPair;
+    typedef std::vector<DispatcherPtr> DispatcherList;
+
+    typedef std::unique_ptr<EventQueueInterface> EventQueuePtr;
+    typedef std::vector<EventQueuePtr> EventQueueList;
+    typedef std::vector<EventQueueInterface*> EventOrderList;
+
+    // Chunk of memory holding events queued from other threads.
+    struct QueuedEventChunk
+    {
+        std::unique_ptr<char[]> memory;
+        std::size_t capacity;
+        std::size_t size;
+    };
+
+    typedef std::vector<QueuedEventChunk> QueuedEventChunkList;
+
+    // Constant variables.
+    enum
+    {
+        QueuedEventChunkSize = 16 * 1024,
+        QueuedEventAlignment = alignof(std::max_align_t),
+    };
 
 public:
     EventSystem()
@@ -27,13 +176,28 @@ public:
 
     void Cleanup()
     {
+        // Discard events queued from other threads.
+        DestroyQueuedEvents(m_incomingChunks, nullptr);
+
+        ClearContainer(m_incomingChunks);
+        ClearContainer(m_flushingChunks);
+        ClearContainer(m_spareChunks);
+
+        ClearContainer(m_pendingOrder);
+        ClearContainer(m_flushingOrder);
+        ClearContainer(m_queues);
         ClearContainer(m_dispatchers);
+
+        m_thread = std::thread::id();
     }
 
     bool Initialize()
     {
         Cleanup();
 
+        // Remember the thread that flushes queued events.
+        m_thread = std::this_thread::get_id();
+
         return true;
     }
 
@@ -41,26 +205,21 @@ public:
     void Subscribe(Receiver<Type>& receiver)
     {
         // Check if we already have this event type declared.
-        auto it = m_dispatchers.find(typeid(Type));
+        int index = TypeId<Type>();
 
-        if(it == m_dispatchers.end())
+        if(index >= (int)m_dispatchers.size())
         {
-            // Create a dispatcher for this event type.
-            auto dispatcher = std::make_unique<Dispatcher<Type>>();
-
-            // Add dispatcher to the list.
-            auto pair = DispatcherPair(typeid(Type), std::move(dispatcher));
-            auto result = m_dispatchers.insert(std::move(pair));
-
-            assert(result.second == true);
-            assert(result.first != m_dispatchers.end());
+            m_dispatchers.resize(index + 1);
+        }
 
-            // Set iterator to the newly inserted element.
-            it = result.first;
+        if(m_dispatchers[index] == nullptr)
+        {
+            // Create a dispatcher for this event type.
+            m_dispatchers[index] = std::make_unique<Dispatcher<Type>>();
         }
 
         // Cast the pointer that we already know is a dispatcher.
-        Dispatcher<Type>* dispatcher = reinterpret_cast<Dispatcher<Type>*>(it->second.get());
+        Dispatcher<Type>* dispatcher = reinterpret_cast<Dispatcher<Type>*>(m_dispatchers[index].get());
 
         // Subscribe receiver to the dispatcher.
         dispatcher->Subscribe(receiver);
@@ -76,14 +235,11 @@ public:
         // wrap the Receiver class (EventReceiver?).
 
         // Find the dispatcher for this event type.
-        auto it = m_dispatchers.find(typeid(Type));
+        Dispatcher<Type>* dispatcher = GetDispatcher<Type>();
 
-        if(it == m_dispatchers.end())
+        if(dispatcher == nullptr)
             return;
 
-        // Cast the pointer that we already know is a dispatcher.
-        Dispatcher<Type>* dispatcher = reinterpret_cast<Dispatcher<Type>*>(it->second.get());
-
         // Unsubscribe receiver from the dispatcher.
         dispatcher->Unsubscribe(receiver);
     }
@@ -92,18 +248,240 @@ public:
     void Dispatch(const Type& event)
     {
         // Find the dispatcher for this event type.
-        auto it = m_dispatchers.find(typeid(Type));
+        Dispatcher<Type>* dispatcher = GetDispatcher<Type>();
 
-        if(it == m_dispatchers.end())
+        if(dispatcher == nullptr)
             return;
 
-        // Cast the pointer that we already know is a dispatcher.
-        Dispatcher<Type>* dispatcher = reinterpret_cast<Dispatcher<Type>*>(it->second.get());
-
         // Dispatch event to all receivers.
         dispatcher->Dispatch(event);
     }
 
+    template<typename Type>
+    void Queue(const Type& event)
+    {
+        if(std::this_thread::get_id() != m_thread)
+        {
+            // Calculate the space taken by the event in a chunk.
+            std::size_t size = (sizeof(QueuedEvent<Type>) + QueuedEventAlignment - 1) & ~(std::size_t)(QueuedEventAlignment - 1);
+
+            // Construct the event after previously queued ones.
+            std::lock_guard<std::mutex> lock(m_incomingMutex);
+
+            QueuedEventChunk& chunk = GetIncomingChunk(size);
+            QueuedEventInterface* queued = new (chunk.memory.get() + chunk.size) QueuedEvent<Type>(event);
+            queued->size = size;
+            chunk.size += size;
+
+            return;
+        }
+
+        // Add the event to the queue of its type.
+        EventQueue<Type>* queue = GetQueue<Type>();
+        queue->Push(event);
+
+        // Remember the order of queued events across all types.
+        m_pendingOrder.push_back(queue);
+    }
+
+    void Flush()
+    {
+        assert(std::this_thread::get_id() == m_thread);
+
+        // Take events queued from other threads.
+        {
+            std::lock_guard<std::mutex> lock(m_incomingMutex);
+            m_flushingChunks.swap(m_incomingChunks);
+        }
+
+        // Move events to queues of their types in the order they were queued.
+        DestroyQueuedEvents(m_flushingChunks, this);
+
+        // Keep emptied chunks for events queued later.
+        if(!m_flushingChunks.empty())
+        {
+            std::lock_guard<std::mutex> lock(m_incomingMutex);
+
+            for(QueuedEventChunk& chunk : m_flushingChunks)
+            {
+                m_spareChunks.push_back(std::move(chunk));
+            }
+        }
+
+        m_flushingChunks.clear();
+
+        // Take pending events of all types before sending any of them.
+        for(auto& queue : m_queues)
+        {
+            if(queue != nullptr)
+            {
+                queue->Take();
+            }
+        }
+
+        assert(m_flushingOrder.empty());
+        m_flushingOrder.swap(m_pendingOrder);
+
+        // Dispatch taken events in the order they were queued.
+        // Events queued by receivers wait for the next flush.
+        std::size_t index = 0;
+
+        while(index < m_flushingOrder.size())
+        {
+            // Find a run of events of the same type.
+            EventQueueInterface* queue = m_flushingOrder[index];
+            std::size_t end = index + 1;
+
+            while(end < m_flushingOrder.size() && m_flushingOrder[end] == queue)
+            {
+                ++end;
+            }
+
+            // Dispatch the run of events.
+            queue->Flush(*this, (int)(end - index));
+            index = end;
+        }
+
+        m_flushingOrder.clear();
+    }
+
+private:
+    QueuedEventChunk& GetIncomingChunk(std::size_t size)
+    {
+        // Use the last chunk if the event fits.
+        if(!m_incomingChunks.empty() && m_incomingChunks.back().capacity - m_incomingChunks.back().size >= size)
+            return m_incomingChunks.back();
+
+        // Reuse a spare chunk or allocate a new one.
+        if(!m_spareChunks.empty() && m_spareChunks.back().capacity >= size)
+        {
+            m_incomingChunks.push_back(std::move(m_spareChunks.back()));
+            m_spareChunks.pop_back();
+        }
+        else
+        {
+            QueuedEventChunk chunk;
+            chunk.capacity = std::max<std::size_t>(QueuedEventChunkSize, size);
+            chunk.memory.reset(new char[chunk.capacity]);
+
+            m_incomingChunks.push_back(std::move(chunk));
+        }
+
+        m_incomingChunks.back().size = 0;
+
+        return m_incomingChunks.back();
+    }
+
+    static void DestroyQueuedEvents(QueuedEventChunkList& chunks, EventSystem* eventSystem)
+    {
+        for(QueuedEventChunk& chunk : chunks)
+        {
+            std::size_t offset = 0;
+
+            while(offset < chunk.size)
+            {
+                QueuedEventInterface* queued = reinterpret_cast<QueuedEventInterface*>(chunk.memory.get() + offset);
+                offset += queued->size;
+
+                // Store the event before destroying it, unless it's being discarded.
+                if(eventSystem != nullptr)
+                {
+                    queued->Store(*eventSystem);
+                }
+
+                queued->~QueuedEventInterface();
+            }
+
+            chunk.size = 0;
+        }
+    }
+
+    template<typename Type>
+    EventQueue<Type>* GetQueue()
+    {
+        // Find the queue for this event type.
+        int index = TypeId<Type>();
+
+        if(index >= (int)m_queues.size())
+        {
+            m_queues.resize(index + 1);
+        }
+
+        if(m_queues[index] == nullptr)
+        {
+            // Create a queue for this event type.
+            m_queues[index] = std::make_unique<EventQueue<Type>>();
+        }
+
+        // Cast the pointer that we already know is an event queue.
+        return reinterpret_cast<EventQueue<Type>*>(m_queues[index].get());
+    }
+
+    template<typename Type>
+    Dispatcher<Type>* GetDispatcher() const
+    {
+        // Find the dispatcher for this event type.
+        int index = TypeId<Type>();
+
+        if(index >= (int)m_dispatchers.size())
+            return nullptr;
+
+        // Cast the pointer that we already know is a dispatcher.
+        return reinterpret_cast<Dispatcher<Type>*>(m_dispatchers[index].get());
+    }
+
 private:
+    // Event dispatchers.
     DispatcherList m_dispatchers;
+
+    // Queues of events by type.
+    EventQueueList m_queues;
+
+    // Queues of pending and flushing events in the order events were queued.
+    EventOrderList m_pendingOrder;
+    EventOrderList m_flushingOrder;
+
+    // Chunks of events queued from other threads,
+    // chunks being flushed and emptied chunks kept for reuse.
+    QueuedEventChunkList m_incomingChunks;
+    QueuedEventChunkList m_flushingChunks;
+    QueuedEventChunkList m_spareChunks;
+    std::mutex m_incomingMutex;
+
+    // Thread that flushes queued events.
+    std::thread::id m_thread;
 };
+
+template<typename Type>
+void EventQueue<Type>::Flush(EventSystem& eventSystem, int count)
+{
+    assert(count > 0 && m_cursor + count <= (int)m_flushing.size());
+
+    // Take the next run of events.
+    int first = m_cursor;
+    m_cursor += count;
+
+    // Send events of the run through the same dispatcher.
+    Dispatcher<Type>* dispatcher = eventSystem.GetDispatcher<Type>();
+
+    if(dispatcher != nullptr)
+    {
+        for(int i = first; i < first + count; ++i)
+        {
+            dispatcher->Dispatch(m_flushing[i]);
+        }
+    }
+
+    // Release events when all of them have been sent.
+    if(m_cursor == (int)m_flushing.size())
+    {
+        m_flushing.clear();
+        m_cursor = 0;
+    }
+}
+
+template<typename Type>
+void QueuedEvent<Type>::Store(EventSystem& eventSystem)
+{
+    eventSystem.Queue(m_event);
+}
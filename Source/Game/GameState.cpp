@@ -4,6 +4,10 @@
 #include "MainGlobal.hpp"
 #include "Scripting/LuaEngine.hpp"
 #include "Game/Event/EventDefinitions.hpp"
+#include "Game/Transform/TransformComponent.hpp"
+#include "Game/Movement/VelocityComponent.hpp"
+#include "Game/Render/RenderComponent.hpp"
+#include "Game/Health/HealthComponent.hpp"
 
 namespace
 {
@@ -52,9 +56,12 @@ bool GameState::Initialize()
     m_services.Set(&m_healthSystem);
     m_services.Set(&m_collisionSystem);
     m_services.Set(&m_scriptSystem);
+    m_services.Set(&m_movementSystem);
     m_services.Set(&m_renderSystem);
     m_services.Set(&m_interfaceSystem);
+    m_services.Set(&m_prefabSystem);
     m_services.Set(&m_spawnSystem);
+    m_services.Set(&m_systemScheduler);
 
     // Initialize the event system.
     if(!m_eventSystem.Initialize())
@@ -88,6 +95,10 @@ bool GameState::Initialize()
     if(!m_scriptSystem.Initialize(m_services))
         return false;
 
+    // Initialize the movement system.
+    if(!m_movementSystem.Initialize(m_services))
+        return false;
+
     // Initialize the render system.
     if(!m_renderSystem.Initialize(m_services))
         return false;
@@ -96,10 +107,71 @@ bool GameState::Initialize()
     if(!m_interfaceSystem.Initialize(m_services))
         return false;
 
+    // Initialize the prefab system.
+    if(!m_prefabSystem.Initialize(m_services))
+        return false;
+
     // Initialize the spawn system.
-    if(!m_spawnSystem.Initialize())
+    if(!m_spawnSystem.Initialize(m_services))
+        return false;
+
+    // Initialize the system scheduler.
+    if(!m_systemScheduler.Initialize())
         return false;
 
+    // Add systems in their update order. Systems that call
+    // into Lua or modify entities must run exclusively.
+    // Queued events are flushed after systems that produce them.
+    m_systemScheduler.AddSystem("Spawn", [this](float timeDelta)
+    {
+        m_spawnSystem.Update(timeDelta);
+    }).Exclusive();
+
+    m_systemScheduler.AddSystem("Entity", [this](float)
+    {
+        m_entitySystem.ProcessCommands();
+    }).Exclusive();
+
+    m_systemScheduler.AddSystem("Collision", [this](float timeDelta)
+    {
+        m_collisionSystem.Update(timeDelta);
+        m_eventSystem.Flush();
+    }).Exclusive();
+
+    m_systemScheduler.AddSystem("Script", [this](float timeDelta)
+    {
+        m_scriptSystem.Update(timeDelta);
+        m_eventSystem.Flush();
+    }).Exclusive();
+
+    m_systemScheduler.AddSystem("Movement", [this](float timeDelta)
+    {
+        m_movementSystem.Update(timeDelta);
+    })
+        .Reads<EntitySystem>()
+        .Writes<TransformComponent>()
+        .Writes<VelocityComponent>()
+        .Writes<MovementSystem>();
+
+    m_systemScheduler.AddSystem("Render", [this](float)
+    {
+        m_renderSystem.Update();
+    })
+        .Reads<EntitySystem>()
+        .Reads<TransformComponent>()
+        .Reads<RenderComponent>()
+        .Writes<RenderSystem>();
+
+    m_systemScheduler.AddSystem("Interface", [this](float timeDelta)
+    {
+        m_interfaceSystem.Update(timeDelta);
+    })
+        .Reads<HealthComponent>()
+        .Reads<IdentitySystem>()
+        .Writes<InterfaceSystem>();
+
+    m_systemScheduler.Finalize();
+
     // Pass system references.
     Lua::push(lua.GetState(), this);
     lua_setglobal(lua.GetState(), "GameState");
@@ -125,9 +197,15 @@ bool GameState::Initialize()
     Lua::push(lua.GetState(), &m_scriptSystem);
     lua_setglobal(lua.GetState(), "ScriptSystem");
 
+    Lua::push(lua.GetState(), &m_movementSystem);
+    lua_setglobal(lua.GetState(), "MovementSystem");
+
     Lua::push(lua.GetState(), &m_renderSystem);
     lua_setglobal(lua.GetState(), "RenderSystem");
 
+    Lua::push(lua.GetState(), &m_prefabSystem);
+    lua_setglobal(lua.GetState(), "PrefabSystem");
+
     Lua::push(lua.GetState(), &m_spawnSystem);
     lua_setglobal(lua.GetState(), "SpawnSystem");
 
@@ -167,9 +245,15 @@ void GameState::Cleanup()
         Lua::push(lua.GetState(), Lua::Nil());
         lua_setglobal(lua.GetState(), "ScriptSystem");
 
+        Lua::push(lua.GetState(), Lua::Nil());
+        lua_setglobal(lua.GetState(), "MovementSystem");
+
         Lua::push(lua.GetState(), Lua::Nil());
         lua_setglobal(lua.GetState(), "RenderSystem");
 
+        Lua::push(lua.GetState(), Lua::Nil());
+        lua_setglobal(lua.GetState(), "PrefabSystem");
+
         Lua::push(lua.GetState(), Lua::Nil());
         lua_setglobal(lua.GetState(), "SpawnSystem");
     }
@@ -181,10 +265,15 @@ void GameState::Cleanup()
     // can be destroyed in a regular reversed order.
     m_entitySystem.DestroyAllEntities();
 
+    // System scheduler.
+    m_systemScheduler.Cleanup();
+
     // Game systems.
     m_spawnSystem.Cleanup();
+    m_prefabSystem.Cleanup();
     m_interfaceSystem.Cleanup();
     m_renderSystem.Cleanup();
+    m_movementSystem.Cleanup();
     m_scriptSystem.Cleanup();
     m_collisionSystem.Cleanup();
     m_healthSystem.Cleanup();
@@ -215,23 +304,8 @@ void GameState::Update(float timeDelta)
     if(!m_initialized)
         return;
 
-    // Update the spawn system.
-    m_spawnSystem.Update(timeDelta);
-
-    // Process entity commands.
-    m_entitySystem.ProcessCommands();
-
-    // Update the collision system.
-    m_collisionSystem.Update(timeDelta);
-
-    // Update the script system.
-    m_scriptSystem.Update(timeDelta);
-
-    // Update the render system.
-    m_renderSystem.Update();
-
-    // Update the interface system.
-    m_interfaceSystem.Update(timeDelta);
+    // Update game systems.
+    m_systemScheduler.Update(timeDelta);
 }
 
 void GameState::Draw()
@@ -296,6 +370,11 @@ ScriptSystem& GameState::GetScriptSystem()
     return m_scriptSystem;
 }
 
+MovementSystem& GameState::GetMovementSystem()
+{
+    return m_movementSystem;
+}
+
 RenderSystem& GameState::GetRenderSystem()
 {
     return m_renderSystem;
@@ -306,7 +385,17 @@ InterfaceSystem& GameState::GetInterfaceSystem()
     return m_interfaceSystem;
 }
 
+PrefabSystem& GameState::GetPrefabSystem()
+{
+    return m_prefabSystem;
+}
+
 SpawnSystem& GameState::GetSpawnSystem()
 {
     return m_spawnSystem;
 }
+
+SystemScheduler& GameState::GetSystemScheduler()
+{
+    return m_systemScheduler;
+}
@@ -11,9 +11,12 @@
 #include "Game/Collision/CollisionSystem.hpp"
 #include "Game/Health/HealthSystem.hpp"
 #include "Game/Script/ScriptSystem.hpp"
+#include "Game/Movement/MovementSystem.hpp"
 #include "Game/Render/RenderSystem.hpp"
 #include "Game/Interface/InterfaceSystem.hpp"
+#include "Game/Prefab/PrefabSystem.hpp"
 #include "Game/Spawn/SpawnSystem.hpp"
+#include "Game/Scheduler/SystemScheduler.hpp"
 
 //
 // Game State
@@ -44,9 +47,12 @@ public:
     HealthSystem&    GetHealthSystem();
     CollisionSystem& GetCollisionSystem();
     ScriptSystem&    GetScriptSystem();
+    MovementSystem&  GetMovementSystem();
     RenderSystem&    GetRenderSystem();
     InterfaceSystem& GetInterfaceSystem();
+    PrefabSystem&    GetPrefabSystem();
     SpawnSystem&     GetSpawnSystem();
+    SystemScheduler& GetSystemScheduler();
 
 private:
     bool m_initialized;
@@ -63,7 +69,12 @@ private:
     HealthSystem    m_healthSystem;
     CollisionSystem m_collisionSystem;
     ScriptSystem    m_scriptSystem;
+    MovementSystem  m_movementSystem;
     RenderSystem    m_renderSystem;
     InterfaceSystem m_interfaceSystem;
+    PrefabSystem    m_prefabSystem;
     SpawnSystem     m_spawnSystem;
+
+    // System scheduler.
+    SystemScheduler m_systemScheduler;
 };
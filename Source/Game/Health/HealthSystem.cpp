@@ -104,23 +104,22 @@ void HealthSystem::Damage(EntityHandle entity, int value)
         currentHealth = std::max(0, currentHealth - value);
         health->SetCurrentHealth(currentHealth);
 
-        // Dispatch an entity health event.
+        // Queue an entity health event.
         {
             GameEvent::EntityHealth event;
             event.entity = entity;
-            event.component = health;
 
-            m_eventSystem->Dispatch(event);
+            m_eventSystem->Queue(event);
         }
 
-        // Dispatch an entity damaged event.
+        // Queue an entity damaged event.
         {
             GameEvent::EntityDamaged event;
             event.entity = entity;
-            event.component = health;
             event.value = value;
+            event.alive = health->IsAlive();
 
-            m_eventSystem->Dispatch(event);
+            m_eventSystem->Queue(event);
         }
     }
 }
@@ -149,23 +148,37 @@ void HealthSystem::Heal(EntityHandle entity, int value)
         currentHealth = std::min(currentHealth + value, health->GetMaximumHealth());
         health->SetCurrentHealth(currentHealth);
 
-        // Dispatch an entity health event.
+        // Queue an entity health event.
         {
             GameEvent::EntityHealth event;
             event.entity = entity;
-            event.component = health;
 
-            m_eventSystem->Dispatch(event);
+            m_eventSystem->Queue(event);
         }
 
-        // Dispatch an entity healed event.
+        // Queue an entity healed event.
         {
             GameEvent::EntityHealed event;
             event.entity = entity;
-            event.component = health;
             event.value = value;
 
-            m_eventSystem->Dispatch(event);
+            m_eventSystem->Queue(event);
         }
     }
 }
+
+bool HealthSystem::IsAlive(EntityHandle entity)
+{
+    assert(m_initialized);
+
+    // Check if handle is valid.
+    if(!m_entitySystem->IsHandleValid(entity))
+        return false;
+
+    // Get the health component.
+    HealthComponent* health = m_componentSystem->Lookup<HealthComponent>(entity);
+    if(health == nullptr) return true;
+
+    // Check the current health.
+    return health->IsAlive();
+}
@@ -26,6 +26,10 @@ public:
     void Damage(EntityHandle entity, int value);
     void Heal(EntityHandle entity, int value);
 
+    // Checks if entity is valid and not dead.
+    // Entities without health components can't die.
+    bool IsAlive(EntityHandle entity);
+
 private:
     // System state.
     bool m_initialized;
@@ -30,7 +30,8 @@ void IdentitySystem::Cleanup()
 
     ClearContainer(m_names);
 
-    m_receiverEntityDestroyed.Cleanup();
+    m_receiverEntitiesDestroyed.Cleanup();
+    m_receiverAllEntitiesDestroyed.Cleanup();
 }
 
 bool IdentitySystem::Initialize(const Services& services)
@@ -44,11 +45,13 @@ bool IdentitySystem::Initialize(const Services& services)
     m_eventSystem = services.Get<EventSystem>();
     if(m_eventSystem == nullptr) return false;
 
-    // Bind event receiver.
-    m_receiverEntityDestroyed.Bind<IdentitySystem, &IdentitySystem::OnEntityDestroyedEvent>(this);
+    // Bind event receivers.
+    m_receiverEntitiesDestroyed.Bind<IdentitySystem, &IdentitySystem::OnEntitiesDestroyedEvent>(this);
+    m_receiverAllEntitiesDestroyed.Bind<IdentitySystem, &IdentitySystem::OnAllEntitiesDestroyedEvent>(this);
 
     // Subscribe to event receivers.
-    m_eventSystem->Subscribe<GameEvent::EntityDestroyed>(m_receiverEntityDestroyed);
+    m_eventSystem->Subscribe<GameEvent::EntitiesDestroyed>(m_receiverEntitiesDestroyed);
+    m_eventSystem->Subscribe<GameEvent::AllEntitiesDestroyed>(m_receiverAllEntitiesDestroyed);
 
     // Success!
     return m_initialized = true;
@@ -122,12 +125,24 @@ EntityHandle IdentitySystem::GetEntityByName(std::string name) const
     }
 }
 
-void IdentitySystem::OnEntityDestroyedEvent(const GameEvent::EntityDestroyed& event)
+void IdentitySystem::OnEntitiesDestroyedEvent(const GameEvent::EntitiesDestroyed& event)
 {
     if(!m_initialized)
         return;
 
-    // Remove entity from the name map.
-    auto result = m_names.right.erase(event.entity);
-    assert(result == 0 || result == 1);
+    // Remove entities from the name map.
+    for(const EntityHandle& entity : event.entities)
+    {
+        auto result = m_names.right.erase(entity);
+        assert(result == 0 || result == 1);
+    }
+}
+
+void IdentitySystem::OnAllEntitiesDestroyedEvent(const GameEvent::AllEntitiesDestroyed&)
+{
+    if(!m_initialized)
+        return;
+
+    // Remove all entities from the name map.
+    m_names.clear();
 }
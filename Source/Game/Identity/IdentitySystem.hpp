@@ -34,7 +34,8 @@ public:
     EntityHandle GetEntityByName(std::string name) const;
 
 private:
-    void OnEntityDestroyedEvent(const GameEvent::EntityDestroyed& event);
+    void OnEntitiesDestroyedEvent(const GameEvent::EntitiesDestroyed& event);
+    void OnAllEntitiesDestroyedEvent(const GameEvent::AllEntitiesDestroyed& event);
 
 private:
     // System state.
@@ -47,5 +48,6 @@ private:
     EntityNameMap m_names;
 
     // Event receivers.
-    Receiver<GameEvent::EntityDestroyed> m_receiverEntityDestroyed;
+    Receiver<GameEvent::EntitiesDestroyed> m_receiverEntitiesDestroyed;
+    Receiver<GameEvent::AllEntitiesDestroyed> m_receiverAllEntitiesDestroyed;
 };
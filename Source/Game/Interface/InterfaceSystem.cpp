@@ -11,6 +11,7 @@
 #include "Game/Transform/TransformComponent.hpp"
 #include "Game/Health/HealthComponent.hpp"
 #include "Game/Render/RenderSystem.hpp"
+#include "Game/Scheduler/SystemScheduler.hpp"
 
 namespace
 {
@@ -22,13 +23,19 @@ namespace
     const bool InterfaceSpaceFloatingText = false;
 }
 
+namespace Console
+{
+    ConsoleVariable debugSystemTimes("debug_systemtimes", false, "Shows update times of game systems.");
+}
+
 InterfaceSystem::InterfaceSystem() :
     m_initialized(false),
     m_eventSystem(nullptr),
     m_entitySystem(nullptr),
     m_identitySystem(nullptr),
     m_componentSystem(nullptr),
-    m_renderSystem(nullptr)
+    m_renderSystem(nullptr),
+    m_systemScheduler(nullptr)
 {
 }
 
@@ -47,6 +54,7 @@ void InterfaceSystem::Cleanup()
     m_identitySystem = nullptr;
     m_componentSystem = nullptr;
     m_renderSystem = nullptr;
+    m_systemScheduler = nullptr;
 
     // Screen space.
     m_screenSpace.Cleanup();
@@ -85,6 +93,9 @@ bool InterfaceSystem::Initialize(const Services& services)
     m_renderSystem = services.Get<RenderSystem>();
     if(m_renderSystem == nullptr) return false;
 
+    m_systemScheduler = services.Get<SystemScheduler>();
+    if(m_systemScheduler == nullptr) return false;
+
     // Bind event receivers.
     m_receiverEntityDamaged.Bind<InterfaceSystem, &InterfaceSystem::OnEntityDamagedEvent>(this);
     m_receiverEntityHealed.Bind<InterfaceSystem, &InterfaceSystem::OnEntityHealedEvent>(this);
@@ -220,6 +231,18 @@ void InterfaceSystem::Draw()
         std::stringstream text;
         text << "Entities: " << m_entitySystem->GetEntityCount();
 
+        // Add update times of game systems.
+        if(Console::debugSystemTimes)
+        {
+            for(int i = 0; i < m_systemScheduler->GetSystemCount(); ++i)
+            {
+                const SystemScheduler::SystemDefinition& system = m_systemScheduler->GetSystem(i);
+
+                text << "\n" << system.GetName() << ": ";
+                text << std::fixed << std::setprecision(3) << system.GetTime() * 1000.0f << " ms";
+            }
+        }
+
         TextDrawInfo info;
         info.font = &Main::GetDefaultFont();
         info.size = 22;
@@ -15,6 +15,7 @@ class EntitySystem;
 class IdentitySystem;
 class ComponentSystem;
 class RenderSystem;
+class SystemScheduler;
 
 //
 // Interface System
@@ -48,6 +49,7 @@ private:
     IdentitySystem*  m_identitySystem;
     ComponentSystem* m_componentSystem;
     RenderSystem*    m_renderSystem;
+    SystemScheduler* m_systemScheduler;
 
     // Screen space.
     ScreenSpace m_screenSpace;
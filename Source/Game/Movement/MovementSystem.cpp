@@ -0,0 +1,173 @@
+#include "Precompiled.hpp"
+#include "MovementSystem.hpp"
+#include "VelocityComponent.hpp"
+
+#include "Common/Services.hpp"
+#include "Game/Entity/EntitySystem.hpp"
+#include "Game/Component/ComponentSystem.hpp"
+#include "Game/Transform/TransformComponent.hpp"
+
+MovementSystem::MovementSystem() :
+    m_initialized(false),
+    m_entitySystem(nullptr),
+    m_componentSystem(nullptr)
+{
+}
+
+MovementSystem::~MovementSystem()
+{
+    Cleanup();
+}
+
+void MovementSystem::Cleanup()
+{
+    m_initialized = false;
+
+    m_entitySystem = nullptr;
+    m_componentSystem = nullptr;
+
+    // Gathered components.
+    ClearContainer(m_transforms);
+    ClearContainer(m_velocities);
+    ClearContainer(m_entities);
+    ClearContainer(m_validity);
+
+    // Packed values.
+    ClearContainer(m_arrays.positionX);
+    ClearContainer(m_arrays.positionY);
+    ClearContainer(m_arrays.rotation);
+    ClearContainer(m_arrays.velocityX);
+    ClearContainer(m_arrays.velocityY);
+    ClearContainer(m_arrays.accelerationX);
+    ClearContainer(m_arrays.accelerationY);
+    ClearContainer(m_arrays.damping);
+    ClearContainer(m_arrays.angularVelocity);
+}
+
+bool MovementSystem::Initialize(const Services& services)
+{
+    Cleanup();
+
+    // Setup scope guard.
+    SCOPE_GUARD_IF(!m_initialized, Cleanup());
+
+    // Get required services.
+    m_entitySystem = services.Get<EntitySystem>();
+    if(m_entitySystem == nullptr) return false;
+
+    m_componentSystem = services.Get<ComponentSystem>();
+    if(m_componentSystem == nullptr) return false;
+
+    // Declare required components.
+    m_componentSystem->Declare<TransformComponent>();
+    m_componentSystem->Declare<VelocityComponent>();
+
+    // Success!
+    return m_initialized = true;
+}
+
+void MovementSystem::Update(float timeDelta)
+{
+    assert(m_initialized);
+
+    // Make sure the gathered lists are clear.
+    m_transforms.clear();
+    m_velocities.clear();
+    m_entities.clear();
+
+    // Gather components of moving entities.
+    auto view = m_componentSystem->View<TransformComponent, VelocityComponent>();
+
+    for(auto it = view.Begin(); it != view.End(); ++it)
+    {
+        m_transforms.push_back(&it.Get<TransformComponent>());
+        m_velocities.push_back(&it.Get<VelocityComponent>());
+        m_entities.push_back(it.GetEntity());
+    }
+
+    // Check which entities are valid.
+    m_entitySystem->ValidateHandles(m_entities.data(), (int)m_entities.size(), m_validity);
+
+    // Pack values of valid entities into separate arrays.
+    MovementArrays& arrays = m_arrays;
+    std::size_t capacity = m_entities.size();
+
+    arrays.positionX.resize(capacity);
+    arrays.positionY.resize(capacity);
+    arrays.rotation.resize(capacity);
+    arrays.velocityX.resize(capacity);
+    arrays.velocityY.resize(capacity);
+    arrays.accelerationX.resize(capacity);
+    arrays.accelerationY.resize(capacity);
+    arrays.damping.resize(capacity);
+    arrays.angularVelocity.resize(capacity);
+
+    float* positionX = arrays.positionX.data();
+    float* positionY = arrays.positionY.data();
+    float* rotation = arrays.rotation.data();
+    float* velocityX = arrays.velocityX.data();
+    float* velocityY = arrays.velocityY.data();
+    float* accelerationX = arrays.accelerationX.data();
+    float* accelerationY = arrays.accelerationY.data();
+    float* damping = arrays.damping.data();
+    float* angularVelocity = arrays.angularVelocity.data();
+
+    int count = 0;
+
+    for(int i = 0; i < (int)m_entities.size(); ++i)
+    {
+        // Skip inactive entities.
+        if(!EntitySystem::IsMaskSet(m_validity, i))
+            continue;
+
+        const TransformComponent& transform = *m_transforms[i];
+        const VelocityComponent& velocity = *m_velocities[i];
+
+        // Keep components of packed values, so they can be written back.
+        m_transforms[count] = m_transforms[i];
+        m_velocities[count] = m_velocities[i];
+
+        positionX[count] = transform.GetPosition().x;
+        positionY[count] = transform.GetPosition().y;
+        rotation[count] = transform.GetRotation();
+        velocityX[count] = velocity.GetLinearVelocity().x;
+        velocityY[count] = velocity.GetLinearVelocity().y;
+        accelerationX[count] = velocity.GetAcceleration().x;
+        accelerationY[count] = velocity.GetAcceleration().y;
+        damping[count] = velocity.GetDamping();
+        angularVelocity[count] = velocity.GetAngularVelocity();
+
+        ++count;
+    }
+
+    // Integrate packed values without branches. Damping is applied
+    // as v = v / (1 + damping * dt), which stays stable for any time step.
+    for(int i = 0; i < count; ++i)
+    {
+        float factor = 1.0f / (1.0f + damping[i] * timeDelta);
+
+        velocityX[i] = (velocityX[i] + accelerationX[i] * timeDelta) * factor;
+        velocityY[i] = (velocityY[i] + accelerationY[i] * timeDelta) * factor;
+
+        positionX[i] += velocityX[i] * timeDelta;
+        positionY[i] += velocityY[i] * timeDelta;
+
+        rotation[i] += angularVelocity[i] * timeDelta;
+    }
+
+    // Write integrated values back to components.
+    for(int i = 0; i < count; ++i)
+    {
+        TransformComponent& transform = *m_transforms[i];
+        VelocityComponent& velocity = *m_velocities[i];
+
+        velocity.SetLinearVelocity(glm::vec2(velocityX[i], velocityY[i]));
+        transform.SetPosition(glm::vec2(positionX[i], positionY[i]));
+
+        // Wrap rotation only of rotating transforms.
+        if(angularVelocity[i] != 0.0f)
+        {
+            transform.SetRotation(rotation[i]);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+#include "Game/Entity/EntityHandle.hpp"
+#include "Game/Entity/EntitySystem.hpp"
+
+// Forward declarations.
+class Services;
+class ComponentSystem;
+class TransformComponent;
+class VelocityComponent;
+
+//
+// Movement System
+//  Integrates velocity components of entities into their transforms.
+//  Components are gathered first, so invalid entities can be filtered
+//  in a batch. Values of valid entities are then packed into separate
+//  arrays, integrated in a loop the compiler can vectorize and written
+//  back to the components.
+//
+
+class MovementSystem
+{
+public:
+    // Type declarations.
+    typedef std::vector<TransformComponent*> TransformList;
+    typedef std::vector<VelocityComponent*> VelocityList;
+    typedef std::vector<float> ValueList;
+
+    struct MovementArrays
+    {
+        ValueList positionX;
+        ValueList positionY;
+        ValueList rotation;
+        ValueList velocityX;
+        ValueList velocityY;
+        ValueList accelerationX;
+        ValueList accelerationY;
+        ValueList damping;
+        ValueList angularVelocity;
+    };
+
+public:
+    MovementSystem();
+    ~MovementSystem();
+
+    bool Initialize(const Services& services);
+    void Cleanup();
+
+    void Update(float timeDelta);
+
+private:
+    // System state.
+    bool m_initialized;
+
+    // Game systems.
+    EntitySystem*    m_entitySystem;
+    ComponentSystem* m_componentSystem;
+
+    // Gathered components of moving entities.
+    TransformList m_transforms;
+    VelocityList m_velocities;
+
+    // Entities of gathered components and their validity.
+    std::vector<EntityHandle> m_entities;
+    EntitySystem::ValidityMask m_validity;
+
+    // Packed values of valid entities.
+    MovementArrays m_arrays;
+};
@@ -0,0 +1,14 @@
+#include "Precompiled.hpp"
+#include "VelocityComponent.hpp"
+
+VelocityComponent::VelocityComponent() :
+    m_linearVelocity(0.0f, 0.0f),
+    m_acceleration(0.0f, 0.0f),
+    m_damping(0.0f),
+    m_angularVelocity(0.0f)
+{
+}
+
+VelocityComponent::~VelocityComponent()
+{
+}
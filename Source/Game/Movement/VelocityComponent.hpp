@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Precompiled.hpp"
+#include "Game/Component/Component.hpp"
+
+//
+// Velocity Component
+//  Moves the transform of an entity every update. Linear velocity and
+//  acceleration are in world units per second, angular velocity is in
+//  degrees per second. Damping slows down the linear velocity over time.
+//
+
+class VelocityComponent : public Component
+{
+public:
+    VelocityComponent();
+    ~VelocityComponent();
+
+    // Sets the linear velocity.
+    void SetLinearVelocity(const glm::vec2& velocity)
+    {
+        m_linearVelocity = velocity;
+    }
+
+    // Sets the linear acceleration.
+    void SetAcceleration(const glm::vec2& acceleration)
+    {
+        m_acceleration = acceleration;
+    }
+
+    // Sets the linear damping.
+    void SetDamping(float damping)
+    {
+        m_damping = damping;
+    }
+
+    // Sets the angular velocity.
+    void SetAngularVelocity(float velocity)
+    {
+        m_angularVelocity = velocity;
+    }
+
+    // Gets the linear velocity.
+    const glm::vec2& GetLinearVelocity() const
+    {
+        return m_linearVelocity;
+    }
+
+    glm::vec2 GetLinearVelocityCopy() const
+    {
+        return m_linearVelocity;
+    }
+
+    // Gets the linear acceleration.
+    const glm::vec2& GetAcceleration() const
+    {
+        return m_acceleration;
+    }
+
+    glm::vec2 GetAccelerationCopy() const
+    {
+        return m_acceleration;
+    }
+
+    // Gets the linear damping.
+    float GetDamping() const
+    {
+        return m_damping;
+    }
+
+    // Gets the angular velocity.
+    float GetAngularVelocity() const
+    {
+        return m_angularVelocity;
+    }
+
+private:
+    // Velocity data.
+    glm::vec2 m_linearVelocity;
+    glm::vec2 m_acceleration;
+    float m_damping;
+    float m_angularVelocity;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+#include "Game/Entity/EntitySystem.hpp"
+#include "Game/Component/ComponentSystem.hpp"
+#include "Game/Script/ScriptComponent.hpp"
+
+//
+// Prototype Copy
+//  Initializes a component with values of its prototype.
+//
+
+template<typename Type>
+void CopyPrototype(const Type& prototype, Type& component)
+{
+    component = prototype;
+}
+
+inline void CopyPrototype(const ScriptComponent& prototype, ScriptComponent& component)
+{
+    // Every entity needs its own script instances.
+    component.CopyScripts(prototype);
+}
+
+//
+// Entity Prefab
+//  Set of component prototypes that entities are created from.
+//  Components of instantiated entities are created in batches
+//  and initialized with copies of prototype values.
+//
+//  Defining a prefab:
+//      EntityPrefab prefab;
+//      TransformComponent* transform = prefab.Add<TransformComponent>();
+//      transform->SetScale(glm::vec2(50.0f, 50.0f));
+//
+//  Instantiating a prefab:
+//      EntitySystem::EntityList entities;
+//      entitySystem->CreateEntities(count, entities);
+//      prefab.Instantiate(*componentSystem, entities);
+//
+
+class EntityPrefab
+{
+public:
+    // Component prototype interface.
+    class PrototypeInterface
+    {
+    public:
+        virtual ~PrototypeInterface()
+        {
+        }
+
+        virtual void Instantiate(ComponentSystem& componentSystem, const EntitySystem::EntityList& entities) = 0;
+    };
+
+    // Component prototype.
+    template<typename Type>
+    class Prototype : public PrototypeInterface
+    {
+    public:
+        void Instantiate(ComponentSystem& componentSystem, const EntitySystem::EntityList& entities)
+        {
+            // Create components of all entities at once.
+            m_components.clear();
+            componentSystem.CreateBatch<Type>(entities, m_components);
+
+            // Copy prototype values.
+            for(Type* component : m_components)
+            {
+                if(component != nullptr)
+                {
+                    CopyPrototype(m_prototype, *component);
+                }
+            }
+        }
+
+        Type* GetPrototype()
+        {
+            return &m_prototype;
+        }
+
+    private:
+        // Prototype component.
+        Type m_prototype;
+
+        // Components created during instantiation.
+        std::vector<Type*> m_components;
+    };
+
+    // Type declarations.
+    typedef std::unique_ptr<PrototypeInterface> PrototypePtr;
+    typedef std::unordered_map<std::type_index, PrototypePtr> PrototypeList;
+    typedef PrototypeList::value_type PrototypePair;
+
+public:
+    EntityPrefab()
+    {
+    }
+
+    ~EntityPrefab()
+    {
+    }
+
+    template<typename Type>
+    Type* Add()
+    {
+        // Validate component type.
+        static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
+
+        // Check if prefab already has this component.
+        if(m_prototypes.find(typeid(Type)) != m_prototypes.end())
+            return nullptr;
+
+        // Create a component prototype.
+        auto prototype = std::make_unique<Prototype<Type>>();
+        Type* component = prototype->GetPrototype();
+
+        // Add prototype to the collection.
+        auto pair = PrototypePair(typeid(Type), std::move(prototype));
+        auto result = m_prototypes.insert(std::move(pair));
+
+        assert(result.second == true);
+
+        // Return a pointer to the prototype component.
+        return component;
+    }
+
+    template<typename Type>
+    Type* Lookup()
+    {
+        // Validate component type.
+        static_assert(std::is_base_of<Component, Type>::value, "Not a component type.");
+
+        // Find prototype by component type.
+        auto it = m_prototypes.find(typeid(Type));
+
+        if(it == m_prototypes.end())
+            return nullptr;
+
+        // Cast the pointer that we already know is a prototype of this type.
+        Prototype<Type>* prototype = static_cast<Prototype<Type>*>(it->second.get());
+
+        // Return a pointer to the prototype component.
+        return prototype->GetPrototype();
+    }
+
+    void Instantiate(ComponentSystem& componentSystem, const EntitySystem::EntityList& entities)
+    {
+        // Create components of every prototype.
+        for(auto& pair : m_prototypes)
+        {
+            pair.second->Instantiate(componentSystem, entities);
+        }
+    }
+
+private:
+    // Component prototypes.
+    PrototypeList m_prototypes;
+};
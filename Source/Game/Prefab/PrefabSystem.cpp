@@ -0,0 +1,145 @@
+#include "Precompiled.hpp"
+#include "PrefabSystem.hpp"
+
+#include "Common/Services.hpp"
+#include "Game/Component/ComponentSystem.hpp"
+#include "Game/Transform/TransformComponent.hpp"
+
+PrefabSystem::PrefabSystem() :
+    m_initialized(false),
+    m_entitySystem(nullptr),
+    m_componentSystem(nullptr)
+{
+}
+
+PrefabSystem::~PrefabSystem()
+{
+    Cleanup();
+}
+
+void PrefabSystem::Cleanup()
+{
+    m_initialized = false;
+
+    // Game systems.
+    m_entitySystem = nullptr;
+    m_componentSystem = nullptr;
+
+    // Prefabs.
+    ClearContainer(m_prefabs);
+    ClearContainer(m_entities);
+}
+
+bool PrefabSystem::Initialize(const Services& services)
+{
+    Cleanup();
+
+    // Setup scope guard.
+    SCOPE_GUARD_IF(!m_initialized, Cleanup());
+
+    // Get required services.
+    m_entitySystem = services.Get<EntitySystem>();
+    if(m_entitySystem == nullptr) return false;
+
+    m_componentSystem = services.Get<ComponentSystem>();
+    if(m_componentSystem == nullptr) return false;
+
+    // Success!
+    return m_initialized = true;
+}
+
+EntityPrefab* PrefabSystem::CreatePrefab(std::string name)
+{
+    if(!m_initialized)
+        return nullptr;
+
+    // Check if the name is valid.
+    if(name.empty())
+    {
+        Log() << "Error: Prefab name can't be empty.";
+        return nullptr;
+    }
+
+    // Check if the name is already used.
+    if(m_prefabs.find(name) != m_prefabs.end())
+    {
+        Log() << "Error: Prefab named \"" << name << "\" already exists.";
+        return nullptr;
+    }
+
+    // Create a new prefab.
+    EntityPrefab* prefab = new EntityPrefab();
+    m_prefabs.emplace(name, PrefabPtr(prefab));
+
+    return prefab;
+}
+
+EntityPrefab* PrefabSystem::GetPrefab(std::string name) const
+{
+    if(!m_initialized)
+        return nullptr;
+
+    // Find prefab by name.
+    auto it = m_prefabs.find(name);
+
+    if(it == m_prefabs.end())
+        return nullptr;
+
+    return it->second.get();
+}
+
+EntityHandle PrefabSystem::Instantiate(EntityPrefab* prefab)
+{
+    if(!m_initialized)
+        return EntityHandle();
+
+    if(prefab == nullptr)
+        return EntityHandle();
+
+    // Create an entity.
+    m_entities.clear();
+    m_entitySystem->CreateEntities(1, m_entities);
+
+    // Create components from prototypes.
+    prefab->Instantiate(*m_componentSystem, m_entities);
+
+    return m_entities.front();
+}
+
+EntityHandle PrefabSystem::InstantiateAt(EntityPrefab* prefab, const glm::vec2& position)
+{
+    if(!m_initialized)
+        return EntityHandle();
+
+    // Create an entity.
+    EntityHandle entity = Instantiate(prefab);
+
+    // Move it to the position.
+    TransformComponent* transform = m_componentSystem->Lookup<TransformComponent>(entity);
+
+    if(transform != nullptr)
+    {
+        transform->SetPosition(position);
+    }
+
+    return entity;
+}
+
+void PrefabSystem::InstantiateMany(EntityPrefab* prefab, int count, EntitySystem::EntityList& entities)
+{
+    if(!m_initialized)
+        return;
+
+    if(prefab == nullptr)
+        return;
+
+    // Create entities.
+    m_entities.clear();
+    m_entitySystem->CreateEntities(count, m_entities);
+
+    // Create components from prototypes.
+    prefab->Instantiate(*m_componentSystem, m_entities);
+
+    // Append created entities to the list.
+    entities.insert(entities.end(), m_entities.begin(), m_entities.end());
+}
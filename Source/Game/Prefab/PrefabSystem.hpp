@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Precompiled.hpp"
+#include "EntityPrefab.hpp"
+
+#include "Game/Entity/EntityHandle.hpp"
+#include "Game/Entity/EntitySystem.hpp"
+
+// Forward declarations.
+class Services;
+class ComponentSystem;
+
+//
+// Prefab System
+//  Keeps named entity prefabs and instantiates them natively.
+//
+
+class PrefabSystem
+{
+public:
+    // Type declarations.
+    typedef std::unique_ptr<EntityPrefab> PrefabPtr;
+    typedef std::unordered_map<std::string, PrefabPtr> PrefabList;
+
+public:
+    PrefabSystem();
+    ~PrefabSystem();
+
+    bool Initialize(const Services& services);
+    void Cleanup();
+
+    // Creates a new prefab. Returns null if the name is already used.
+    EntityPrefab* CreatePrefab(std::string name);
+
+    // Finds a prefab by its name.
+    EntityPrefab* GetPrefab(std::string name) const;
+
+    // Creates an entity from a prefab.
+    EntityHandle Instantiate(EntityPrefab* prefab);
+
+    // Creates an entity from a prefab at a position.
+    EntityHandle InstantiateAt(EntityPrefab* prefab, const glm::vec2& position);
+
+    // Creates a number of entities from a prefab and appends their handles to the list.
+    void InstantiateMany(EntityPrefab* prefab, int count, EntitySystem::EntityList& entities);
+
+private:
+    // System state.
+    bool m_initialized;
+
+    // Game systems.
+    EntitySystem*    m_entitySystem;
+    ComponentSystem* m_componentSystem;
+
+    // List of prefabs.
+    PrefabList m_prefabs;
+
+    // Entities being instantiated.
+    EntitySystem::EntityList m_entities;
+};
@@ -48,6 +48,8 @@ void RenderSystem::Cleanup()
 
     // Processed render components.
     ClearContainer(m_sprites);
+    ClearContainer(m_entities);
+    ClearContainer(m_validity);
 }
 
 bool RenderSystem::Initialize(const Services& services)
@@ -148,34 +150,42 @@ void RenderSystem::Update()
 
     // Make sure the sprite list is clear.
     m_sprites.clear();
+    m_entities.clear();
 
     // Process render components.
-    auto componentsBegin = m_componentSystem->Begin<RenderComponent>();
-    auto componentsEnd = m_componentSystem->End<RenderComponent>();
+    // Drive the view by the render pool, so sprites are drawn in its order.
+    auto view = m_componentSystem->OrderedView<RenderComponent, TransformComponent, RenderComponent>();
 
-    for(auto it = componentsBegin; it != componentsEnd; ++it)
+    for(auto it = view.Begin(); it != view.End(); ++it)
     {
-        // Check if entity is active.
-        if(!m_entitySystem->IsHandleValid(it->first))
-            continue;
-
-        // Get the render component.
-        RenderComponent& render = it->second;
-    
-        // Get other components.
-        TransformComponent* transform = m_componentSystem->Lookup<TransformComponent>(it->first);
-
-        if(transform == nullptr)
-            continue;
+        // Get components.
+        TransformComponent& transform = it.Get<TransformComponent>();
+        RenderComponent& render = it.Get<RenderComponent>();
 
         // Add a sprite to the list.
         Sprite sprite;
-        sprite.transform = transform->CalculateMatrix();
+        sprite.transform = transform.CalculateMatrix();
         sprite.diffuseColor = render.GetDiffuseColor();
         sprite.emissionColor = render.GetEmissionColor();
         sprite.emissionPower = render.GetEmissionPower();
         m_sprites.push_back(sprite);
+        m_entities.push_back(it.GetEntity());
+    }
+
+    // Remove sprites of inactive entities.
+    m_entitySystem->ValidateHandles(m_entities.data(), (int)m_entities.size(), m_validity);
+
+    int spriteCount = 0;
+
+    for(int i = 0; i < (int)m_sprites.size(); ++i)
+    {
+        if(EntitySystem::IsMaskSet(m_validity, i))
+        {
+            m_sprites[spriteCount++] = m_sprites[i];
+        }
     }
+
+    m_sprites.resize(spriteCount);
 }
 
 void RenderSystem::Draw()
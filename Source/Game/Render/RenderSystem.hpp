@@ -6,9 +6,11 @@
 #include "Graphics/VertexInput.hpp"
 #include "Graphics/ScreenSpace.hpp"
 
+#include "Game/Entity/EntityHandle.hpp"
+#include "Game/Entity/EntitySystem.hpp"
+
 // Forward declarations.
 class Services;
-class EntitySystem;
 class ComponentSystem;
 
 //
@@ -61,4 +63,8 @@ private:
 
     // Processed render components.
     std::vector<Sprite> m_sprites;
+
+    // Entities of sprites and their validity.
+    std::vector<EntityHandle> m_entities;
+    EntitySystem::ValidityMask m_validity;
 };
@@ -0,0 +1,222 @@
+#include "Precompiled.hpp"
+#include "SystemScheduler.hpp"
+
+#include "MainGlobal.hpp"
+#include "Common/JobSystem.hpp"
+
+namespace Console
+{
+    ConsoleVariable parallelSystems("g_parallelsystems", true, "Runs independent game systems in parallel.");
+}
+
+SystemScheduler::SystemScheduler() :
+    m_initialized(false),
+    m_finalized(false),
+    m_completed(0)
+{
+}
+
+SystemScheduler::~SystemScheduler()
+{
+    Cleanup();
+}
+
+bool SystemScheduler::Initialize()
+{
+    Cleanup();
+
+    return m_initialized = true;
+}
+
+void SystemScheduler::Cleanup()
+{
+    m_initialized = false;
+    m_finalized = false;
+
+    ClearContainer(m_systems);
+
+    m_completed = 0;
+}
+
+SystemScheduler::SystemDefinition& SystemScheduler::AddSystem(std::string name, SystemFunction function)
+{
+    assert(m_initialized);
+    assert(!m_finalized);
+
+    // Add a system definition.
+    m_systems.emplace_back(name, function);
+
+    return m_systems.back();
+}
+
+void SystemScheduler::Finalize()
+{
+    assert(m_initialized);
+    assert(!m_finalized);
+
+    // Make each system depend on every earlier system it conflicts with.
+    // This preserves the serial update order between conflicting systems.
+    for(unsigned int i = 0; i < m_systems.size(); ++i)
+    {
+        for(unsigned int j = 0; j < i; ++j)
+        {
+            if(IsConflicting(m_systems[j], m_systems[i]))
+            {
+                m_systems[j].m_dependents.push_back(i);
+                m_systems[i].m_dependencyCount += 1;
+            }
+        }
+    }
+
+    m_finalized = true;
+}
+
+void SystemScheduler::Update(float timeDelta)
+{
+    assert(m_finalized);
+
+    JobSystem& jobSystem = Main::GetJobSystem();
+
+    // Run systems serially if parallel execution isn't possible.
+    if(!Console::parallelSystems || jobSystem.GetWorkerCount() == 0)
+    {
+        for(SystemDefinition& system : m_systems)
+        {
+            Execute(system, timeDelta);
+        }
+
+        return;
+    }
+
+    // Reset execution state.
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for(SystemDefinition& system : m_systems)
+    {
+        system.m_remaining = system.m_dependencyCount;
+        system.m_started = false;
+    }
+
+    m_completed = 0;
+
+    // Run systems as soon as their dependencies are complete.
+    while(m_completed < (int)m_systems.size())
+    {
+        // Find the earliest system that's ready to run.
+        SystemDefinition* ready = nullptr;
+
+        for(SystemDefinition& system : m_systems)
+        {
+            if(!system.m_started && system.m_remaining == 0)
+            {
+                ready = &system;
+                break;
+            }
+        }
+
+        // Help with pending jobs while waiting for running systems to complete.
+        if(ready == nullptr)
+        {
+            int completed = m_completed;
+
+            lock.unlock();
+            bool helped = jobSystem.RunJob();
+            lock.lock();
+
+            if(!helped)
+            {
+                m_condition.wait(lock, [this, completed]()
+                {
+                    return m_completed != completed;
+                });
+            }
+
+            continue;
+        }
+
+        ready->m_started = true;
+
+        if(ready->m_exclusive)
+        {
+            // Run exclusive system on the main thread.
+            lock.unlock();
+            Execute(*ready, timeDelta);
+            lock.lock();
+
+            Complete(*ready);
+        }
+        else
+        {
+            // Run system on a worker thread.
+            jobSystem.Submit([this, ready, timeDelta]()
+            {
+                Execute(*ready, timeDelta);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Complete(*ready);
+                m_condition.notify_one();
+            });
+        }
+    }
+}
+
+int SystemScheduler::GetSystemCount() const
+{
+    return (int)m_systems.size();
+}
+
+const SystemScheduler::SystemDefinition& SystemScheduler::GetSystem(int index) const
+{
+    assert(index >= 0 && index < (int)m_systems.size());
+    return m_systems[index];
+}
+
+bool SystemScheduler::IsConflicting(const SystemDefinition& first, const SystemDefinition& second) const
+{
+    // Exclusive systems conflict with everything.
+    if(first.m_exclusive || second.m_exclusive)
+        return true;
+
+    // Check if one system writes a resource the other one accesses.
+    auto Contains = [](const ResourceList& list, int resource)
+    {
+        return std::find(list.begin(), list.end(), resource) != list.end();
+    };
+
+    for(int resource : first.m_writes)
+    {
+        if(Contains(second.m_reads, resource) || Contains(second.m_writes, resource))
+            return true;
+    }
+
+    for(int resource : second.m_writes)
+    {
+        if(Contains(first.m_reads, resource))
+            return true;
+    }
+
+    return false;
+}
+
+void SystemScheduler::Execute(SystemDefinition& system, float timeDelta)
+{
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    // Run the system.
+    system.m_function(timeDelta);
+
+    // Measure the update time.
+    auto end = std::chrono::high_resolution_clock::now();
+    system.m_time = std::chrono::duration<float>(end - begin).count();
+}
+
+void SystemScheduler::Complete(SystemDefinition& system)
+{
+    // Release dependent systems.
+    for(int index : system.m_dependents)
+    {
+        m_systems[index].m_remaining -= 1;
+    }
+
+    m_completed += 1;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+#include "Common/TypeId.hpp"
+
+//
+// System Scheduler
+//  Runs game systems in the order they were added, executing systems
+//  that don't share any written resources in parallel. Resources are
+//  usually component or system types. Exclusive systems (e.g. those
+//  that call into Lua) run on the main thread and are never run
+//  alongside other systems. Resources are identified by TypeId, so
+//  the scheduler doesn't depend on run-time type information.
+//
+//  Adding a system:
+//      scheduler.AddSystem("Render", [&](float timeDelta) { renderSystem.Update(); })
+//          .Reads<TransformComponent>()
+//          .Reads<RenderComponent>()
+//          .Writes<RenderSystem>();
+//
+
+class SystemScheduler
+{
+public:
+    // Type declarations.
+    typedef std::function<void(float)> SystemFunction;
+    typedef std::vector<int> ResourceList;
+    typedef std::vector<int> IndexList;
+
+    // System definition.
+    class SystemDefinition
+    {
+    public:
+        friend SystemScheduler;
+
+    public:
+        SystemDefinition(std::string name, SystemFunction function) :
+            m_name(name),
+            m_function(function),
+            m_exclusive(false),
+            m_dependencyCount(0),
+            m_remaining(0),
+            m_started(false),
+            m_time(0.0f)
+        {
+        }
+
+        template<typename Type>
+        SystemDefinition& Reads()
+        {
+            m_reads.push_back(TypeId<Type>());
+            return *this;
+        }
+
+        template<typename Type>
+        SystemDefinition& Writes()
+        {
+            m_writes.push_back(TypeId<Type>());
+            return *this;
+        }
+
+        SystemDefinition& Exclusive()
+        {
+            m_exclusive = true;
+            return *this;
+        }
+
+        const std::string& GetName() const
+        {
+            return m_name;
+        }
+
+        float GetTime() const
+        {
+            return m_time;
+        }
+
+    private:
+        // System properties.
+        std::string    m_name;
+        SystemFunction m_function;
+        ResourceList   m_reads;
+        ResourceList   m_writes;
+        bool           m_exclusive;
+
+        // Dependency graph.
+        IndexList m_dependents;
+        int       m_dependencyCount;
+
+        // Execution state.
+        int   m_remaining;
+        bool  m_started;
+        float m_time;
+    };
+
+    typedef std::vector<SystemDefinition> SystemList;
+
+public:
+    SystemScheduler();
+    ~SystemScheduler();
+
+    bool Initialize();
+    void Cleanup();
+
+    // Adds a system at the end of the update order.
+    SystemDefinition& AddSystem(std::string name, SystemFunction function);
+
+    // Builds the dependency graph from declared resources.
+    void Finalize();
+
+    // Runs all systems.
+    void Update(float timeDelta);
+
+    // Gets the number of systems.
+    int GetSystemCount() const;
+
+    // Gets a system definition.
+    const SystemDefinition& GetSystem(int index) const;
+
+private:
+    bool IsConflicting(const SystemDefinition& first, const SystemDefinition& second) const;
+    void Execute(SystemDefinition& system, float timeDelta);
+    void Complete(SystemDefinition& system);
+
+private:
+    // System state.
+    bool m_initialized;
+    bool m_finalized;
+
+    // List of systems.
+    SystemList m_systems;
+
+    // Execution synchronization.
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    int m_completed;
+};
@@ -1,7 +1,24 @@
 #include "Precompiled.hpp"
 #include "ScriptComponent.hpp"
 
-ScriptComponent::ScriptComponent()
+namespace
+{
+    // Names of script callback functions.
+    const char* CallbackNames[ScriptCallbacks::Count] =
+    {
+        "OnCreated",
+        "OnDestroyed",
+        "OnUpdate",
+        "OnUpdateBatch",
+        "OnDamaged",
+        "OnHeal",
+        "OnCollision",
+        "OnCollisionBatch",
+    };
+}
+
+ScriptComponent::ScriptComponent() :
+    m_callbackMask(0)
 {
 }
 
@@ -25,6 +42,89 @@ void ScriptComponent::AddScript(Lua::LuaRef script)
         return;
     }
 
+    // Resolve script callbacks.
+    Script entry;
+    entry.instance = script;
+
+    for(int i = 0; i < ScriptCallbacks::Count; ++i)
+    {
+        Lua::LuaRef function = script[CallbackNames[i]];
+
+        if(function.isFunction())
+        {
+            entry.callbacks[i] = function;
+            m_callbackMask |= 1 << i;
+        }
+    }
+
     // Add script to the list.
-    m_scripts.push_back(script);
+    m_scripts.push_back(entry);
+}
+
+void ScriptComponent::CopyScripts(const ScriptComponent& other)
+{
+    for(const Script& original : other.m_scripts)
+    {
+        const Lua::LuaRef& script = original.instance;
+        lua_State* state = script.state();
+
+        // Create a new instance table.
+        lua_newtable(state);
+
+        // Copy all fields of the script instance.
+        script.push(state);
+        lua_pushnil(state);
+
+        while(lua_next(state, -2) != 0)
+        {
+            lua_pushvalue(state, -2);
+            lua_insert(state, -2);
+            lua_rawset(state, -5);
+        }
+
+        // Share the metatable with methods of the script.
+        if(lua_getmetatable(state, -1))
+        {
+            lua_setmetatable(state, -3);
+        }
+
+        lua_pop(state, 1);
+
+        // Add script copy to the list.
+        // Copies have the same callbacks as the original.
+        Script entry = original;
+        entry.instance = Lua::LuaRef::fromStack(state, -1);
+        lua_pop(state, 1);
+
+        m_scripts.push_back(entry);
+    }
+
+    m_callbackMask |= other.m_callbackMask;
+}
+
+void ScriptComponent::CallStack(lua_State* state, int arguments)
+{
+    // Call the function.
+    if(lua_pcall(state, arguments, 0, 0) != 0)
+    {
+        std::string error = "Unknown error";
+
+        if(lua_isstring(state, -1))
+        {
+            error = lua_tostring(state, -1);
+
+            // Remove base path to working directory.
+            std::size_t position = error.find(Main::GetWorkingDir());
+
+            if(position != std::string::npos)
+            {
+                error.erase(position, Main::GetWorkingDir().size());
+            }
+        }
+
+        lua_pop(state, 1);
+
+        // Print the error.
+        Log() << "Lua error - " << error << ".";
+    }
 }
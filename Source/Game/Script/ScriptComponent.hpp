@@ -5,15 +5,52 @@
 #include "MainGlobal.hpp"
 #include "Game/Component/Component.hpp"
 
+//
+// Script Callbacks
+//  Functions of script instances called by the script system.
+//
+
+struct ScriptCallbacks
+{
+    enum Type
+    {
+        OnCreated,
+        OnDestroyed,
+        OnUpdate,
+        OnUpdateBatch,
+        OnDamaged,
+        OnHeal,
+        OnCollision,
+        OnCollisionBatch,
+
+        Count,
+    };
+};
+
 //
 // Script Component
+//  Callback functions of scripts are resolved once when a script is added
+//  and kept as registry references. Calls push them directly on the Lua
+//  stack instead of looking them up by name, and callbacks that no script
+//  defines are skipped without touching Lua at all.
+//
+//  Functions assigned to script instances after they have been added
+//  will not be called.
 //
 
 class ScriptComponent : public Component
 {
 public:
     // Type declarations.
-    typedef std::vector<Lua::LuaRef> ScriptList;
+    typedef uint32_t CallbackMask;
+
+    struct Script
+    {
+        Lua::LuaRef instance;
+        Lua::LuaRef callbacks[ScriptCallbacks::Count];
+    };
+
+    typedef std::vector<Script> ScriptList;
 
 public:
     ScriptComponent();
@@ -21,46 +58,82 @@ public:
 
     void AddScript(Lua::LuaRef script);
 
+    // Adds copies of script instances from another component.
+    // Instance tables are copied shallowly and share their metatables.
+    void CopyScripts(const ScriptComponent& other);
+
+    // Calls a callback of every script that defines it.
+    template<typename... Arguments>
+    void Call(ScriptCallbacks::Type callback, const Arguments&... arguments);
+
+    // Calls a script function and logs errors it raises.
     template<typename... Arguments>
-    void Call(std::string name, Arguments... arguments);
+    static void CallFunction(const Lua::LuaRef& function, const Arguments&... arguments);
+
+    bool HasCallback(ScriptCallbacks::Type callback) const
+    {
+        return (m_callbackMask & (1 << callback)) != 0;
+    }
+
+    const ScriptList& GetScripts() const
+    {
+        return m_scripts;
+    }
+
+private:
+    // Pushes function arguments on the Lua stack.
+    static void PushArguments(lua_State*)
+    {
+    }
+
+    template<typename Argument, typename... Arguments>
+    static void PushArguments(lua_State* state, const Argument& argument, const Arguments&... arguments)
+    {
+        Lua::Stack<Argument>::push(state, argument);
+        PushArguments(state, arguments...);
+    }
+
+    // Calls a function with its arguments on the Lua stack.
+    static void CallStack(lua_State* state, int arguments);
 
 private:
     ScriptList m_scripts;
+
+    // Callbacks defined by any of the scripts.
+    CallbackMask m_callbackMask;
 };
 
 template<typename... Arguments>
-void ScriptComponent::Call(std::string name, Arguments... arguments)
+void ScriptComponent::Call(ScriptCallbacks::Type callback, const Arguments&... arguments)
 {
+    assert(callback >= 0 && callback < ScriptCallbacks::Count);
+
+    // Check if any script defines the callback.
+    if(!HasCallback(callback))
+        return;
+
     // Execute every script in order.
-    for(Lua::LuaRef& script : m_scripts)
+    for(const Script& script : m_scripts)
     {
-        // Get the function reference.
-        Lua::LuaRef function = script[name];
+        const Lua::LuaRef& function = script.callbacks[callback];
 
-        // Call the function.
-        if(function.isFunction())
+        // Call method with a self argument.
+        if(!function.isNil())
         {
-            try
-            {
-                // Call method with a self argument.
-                function(script, arguments...);
-            }
-            catch(Lua::LuaException& exception)
-            {
-                // Get the exception error text.
-                std::string error = exception.what();
-
-                // Remove base path to working directory.
-                std::size_t position = error.find(Main::GetWorkingDir());
-
-                if(position != std::string::npos)
-                {
-                    error.erase(position, Main::GetWorkingDir().size());
-                }
-
-                // Print the error.
-                Log() << "Lua error - " << error << ".";
-            }
+            CallFunction(function, script.instance, arguments...);
         }
     }
 }
+
+template<typename... Arguments>
+void ScriptComponent::CallFunction(const Lua::LuaRef& function, const Arguments&... arguments)
+{
+    lua_State* state = function.state();
+
+    // Push the function and its arguments.
+    function.push(state);
+    PushArguments(state, arguments...);
+
+    // Call the function.
+    CallStack(state, sizeof...(Arguments));
+}
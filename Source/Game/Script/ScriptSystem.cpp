@@ -31,11 +31,18 @@ void ScriptSystem::Cleanup()
     m_componentSystem = nullptr;
 
     // Event receivers.
-    m_receiverEntityCreated.Cleanup();
-    m_receiverEntityDestroyed.Cleanup();
+    m_receiverEntitiesCreated.Cleanup();
+    m_receiverEntitiesDestroyed.Cleanup();
     m_receiverEntityDamaged.Cleanup();
     m_receiverEntityHealed.Cleanup();
     m_receiverEntityCollsion.Cleanup();
+    m_receiverEntityCollisionBatch.Cleanup();
+
+    // Collision batches.
+    ClearContainer(m_collisionBatches);
+
+    // Update batches.
+    ClearContainer(m_updateBatches);
 }
 
 bool ScriptSystem::Initialize(const Services& services)
@@ -56,18 +63,20 @@ bool ScriptSystem::Initialize(const Services& services)
     if(m_componentSystem == nullptr) return false;
 
     // Bind event receivers.
-    m_receiverEntityCreated.Bind<ScriptSystem, &ScriptSystem::OnEntityCreatedEvent>(this);
-    m_receiverEntityDestroyed.Bind<ScriptSystem, &ScriptSystem::OnEntityDestroyedEvent>(this);
+    m_receiverEntitiesCreated.Bind<ScriptSystem, &ScriptSystem::OnEntitiesCreatedEvent>(this);
+    m_receiverEntitiesDestroyed.Bind<ScriptSystem, &ScriptSystem::OnEntitiesDestroyedEvent>(this);
     m_receiverEntityDamaged.Bind<ScriptSystem, &ScriptSystem::OnEntityDamagedEvent>(this);
     m_receiverEntityHealed.Bind<ScriptSystem, &ScriptSystem::OnEntityHealedEvent>(this);
     m_receiverEntityCollsion.Bind<ScriptSystem, &ScriptSystem::OnEntityCollisionEvent>(this);
+    m_receiverEntityCollisionBatch.Bind<ScriptSystem, &ScriptSystem::OnEntityCollisionBatchEvent>(this);
 
     // Subscribe event receivers.
-    m_eventSystem->Subscribe(m_receiverEntityCreated);
-    m_eventSystem->Subscribe(m_receiverEntityDestroyed);
+    m_eventSystem->Subscribe(m_receiverEntitiesCreated);
+    m_eventSystem->Subscribe(m_receiverEntitiesDestroyed);
     m_eventSystem->Subscribe(m_receiverEntityDamaged);
     m_eventSystem->Subscribe(m_receiverEntityHealed);
     m_eventSystem->Subscribe(m_receiverEntityCollsion);
+    m_eventSystem->Subscribe(m_receiverEntityCollisionBatch);
 
     // Declare required components.
     m_componentSystem->Declare<ScriptComponent>();
@@ -86,39 +95,132 @@ void ScriptSystem::Update(float timeDelta)
 
     for(auto it = componentsBegin; it != componentsEnd; ++it)
     {
-        // Check if entity is active.
-        if(!m_entitySystem->IsHandleValid(it->first))
-            continue;
-
         // Get the script component.
         ScriptComponent& script = it->second;
 
-        // Call OnUpdate() function.
-        script.Call("OnUpdate", it->first, timeDelta);
+        // Skip components without any update function.
+        if(!script.HasCallback(ScriptCallbacks::OnUpdate) && !script.HasCallback(ScriptCallbacks::OnUpdateBatch))
+            continue;
+
+        // Check if entity is active. This also skips free component slots
+        // and entities created during the update in reused slots.
+        if(!m_entitySystem->IsHandleActive(it->first))
+            continue;
+
+        for(const ScriptComponent::Script& instance : script.GetScripts())
+        {
+            // Add scripts that update in batches to the batch of their type.
+            const Lua::LuaRef& batchFunction = instance.callbacks[ScriptCallbacks::OnUpdateBatch];
+
+            if(!batchFunction.isNil())
+            {
+                AddToUpdateBatch(batchFunction, instance.instance, it->first);
+                continue;
+            }
+
+            // Call OnUpdate() function.
+            const Lua::LuaRef& function = instance.callbacks[ScriptCallbacks::OnUpdate];
+
+            if(!function.isNil())
+            {
+                ScriptComponent::CallFunction(function, instance.instance, it->first, timeDelta);
+            }
+        }
+    }
+
+    // Call OnUpdateBatch() function once for each script type.
+    for(UpdateBatch& batch : m_updateBatches)
+    {
+        lua_State* state = batch.function.state();
+
+        // Remove entries left from a larger batch of the previous update.
+        batch.scripts.push(state);
+        batch.entities.push(state);
+
+        for(int i = batch.count + 1; i <= batch.size; ++i)
+        {
+            lua_pushnil(state);
+            lua_rawseti(state, -3, i);
+
+            lua_pushnil(state);
+            lua_rawseti(state, -2, i);
+        }
+
+        lua_pop(state, 2);
+
+        batch.size = batch.count;
+        batch.count = 0;
+
+        // Call the batch function.
+        if(batch.size != 0)
+        {
+            ScriptComponent::CallFunction(batch.function, batch.scripts, batch.entities, timeDelta);
+        }
     }
 }
 
-void ScriptSystem::OnEntityCreatedEvent(const GameEvent::EntityCreated& event)
+void ScriptSystem::AddToUpdateBatch(const Lua::LuaRef& function, const Lua::LuaRef& script, const EntityHandle& entity)
 {
-    assert(m_initialized);
+    lua_State* state = function.state();
 
-    ScriptComponent* script = m_componentSystem->Lookup<ScriptComponent>(event.entity);
+    // Scripts sharing the same OnUpdateBatch() function are of the same type.
+    function.push(state);
+    const void* identity = lua_topointer(state, -1);
+    lua_pop(state, 1);
 
-    if(script != nullptr)
+    // Find the batch of the script type.
+    auto batch = std::find_if(m_updateBatches.begin(), m_updateBatches.end(), [&](const UpdateBatch& batch)
+    {
+        return batch.identity == identity;
+    });
+
+    if(batch == m_updateBatches.end())
     {
-        script->Call("OnCreated", event.entity);
+        m_updateBatches.emplace_back(function, identity);
+        batch = m_updateBatches.end() - 1;
     }
+
+    // Append the script and its entity to the batch arrays.
+    batch->count += 1;
+
+    batch->scripts.push(state);
+    script.push(state);
+    lua_rawseti(state, -2, batch->count);
+
+    batch->entities.push(state);
+    Lua::Stack<EntityHandle>::push(state, entity);
+    lua_rawseti(state, -2, batch->count);
+
+    lua_pop(state, 2);
 }
 
-void ScriptSystem::OnEntityDestroyedEvent(const GameEvent::EntityDestroyed& event)
+void ScriptSystem::OnEntitiesCreatedEvent(const GameEvent::EntitiesCreated& event)
 {
     assert(m_initialized);
 
-    ScriptComponent* script = m_componentSystem->Lookup<ScriptComponent>(event.entity);
+    for(const EntityHandle& entity : event.entities)
+    {
+        ScriptComponent* script = m_componentSystem->Lookup<ScriptComponent>(entity);
 
-    if(script != nullptr)
+        if(script != nullptr)
+        {
+            script->Call(ScriptCallbacks::OnCreated, entity);
+        }
+    }
+}
+
+void ScriptSystem::OnEntitiesDestroyedEvent(const GameEvent::EntitiesDestroyed& event)
+{
+    assert(m_initialized);
+
+    for(const EntityHandle& entity : event.entities)
     {
-        script->Call("OnDestroyed", event.entity);
+        ScriptComponent* script = m_componentSystem->Lookup<ScriptComponent>(entity);
+
+        if(script != nullptr)
+        {
+            script->Call(ScriptCallbacks::OnDestroyed, entity);
+        }
     }
 }
 
@@ -130,7 +232,7 @@ void ScriptSystem::OnEntityDamagedEvent(const GameEvent::EntityDamaged& event)
 
     if(script != nullptr)
     {
-        script->Call("OnDamaged", event.entity, event.value, event.component->IsAlive());
+        script->Call(ScriptCallbacks::OnDamaged, event.entity, event.value, event.alive);
     }
 }
 
@@ -142,7 +244,7 @@ void ScriptSystem::OnEntityHealedEvent(const GameEvent::EntityHealed& event)
 
     if(script != nullptr)
     {
-        script->Call("OnHeal", event.entity, event.value);
+        script->Call(ScriptCallbacks::OnHeal, event.entity, event.value);
     }
 }
 
@@ -152,8 +254,80 @@ void ScriptSystem::OnEntityCollisionEvent(const GameEvent::EntityCollision& even
 
     ScriptComponent* script = m_componentSystem->Lookup<ScriptComponent>(event.self.entity);
 
-    if(script != nullptr)
+    if(script == nullptr)
+        return;
+
+    // Call OnCollision() function of scripts that don't handle collisions in batches.
+    if(!script->HasCallback(ScriptCallbacks::OnCollision))
+        return;
+
+    for(const ScriptComponent::Script& instance : script->GetScripts())
     {
-        script->Call("OnCollision", event.self, event.other);
+        if(!instance.callbacks[ScriptCallbacks::OnCollisionBatch].isNil())
+            continue;
+
+        const Lua::LuaRef& function = instance.callbacks[ScriptCallbacks::OnCollision];
+
+        if(!function.isNil())
+        {
+            ScriptComponent::CallFunction(function, instance.instance, event.self, event.other);
+        }
     }
 }
+
+void ScriptSystem::OnEntityCollisionBatchEvent(const GameEvent::EntityCollisionBatch& event)
+{
+    assert(m_initialized);
+
+    // Gather contacts of scripts that handle collisions in batches.
+    // Scripts sharing the same OnCollisionBatch() function are of the same type.
+    for(const auto& contact : event.contacts)
+    {
+        const CollisionObject& self = *contact.first;
+        const CollisionObject& other = *contact.second;
+
+        ScriptComponent* script = m_componentSystem->Lookup<ScriptComponent>(self.entity);
+
+        if(script == nullptr)
+            continue;
+
+        if(!script->HasCallback(ScriptCallbacks::OnCollisionBatch))
+            continue;
+
+        for(const ScriptComponent::Script& instance : script->GetScripts())
+        {
+            const Lua::LuaRef& function = instance.callbacks[ScriptCallbacks::OnCollisionBatch];
+
+            if(function.isNil())
+                continue;
+
+            // Find the batch of the script type.
+            auto batch = std::find_if(m_collisionBatches.begin(), m_collisionBatches.end(), [&](const CollisionBatch& batch)
+            {
+                return batch.function.rawequal(function);
+            });
+
+            if(batch == m_collisionBatches.end())
+            {
+                m_collisionBatches.emplace_back(function);
+                batch = m_collisionBatches.end() - 1;
+            }
+
+            // Add the contact to the batch.
+            Lua::LuaRef entry = Lua::LuaRef::newTable(function.state());
+            entry["script"] = instance.instance;
+            entry["self"] = self;
+            entry["other"] = other;
+
+            batch->contacts.append(entry);
+        }
+    }
+
+    // Call OnCollisionBatch() function once for each script type.
+    for(const CollisionBatch& batch : m_collisionBatches)
+    {
+        ScriptComponent::CallFunction(batch.function, batch.contacts);
+    }
+
+    m_collisionBatches.clear();
+}
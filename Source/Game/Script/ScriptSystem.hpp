@@ -12,10 +12,59 @@ class ComponentSystem;
 
 //
 // Script System
+//  Scripts that define OnUpdateBatch(scripts, entities, timeDelta) are
+//  updated in batches instead of calling their OnUpdate() function. It is
+//  called once per script type with arrays of all script instances of
+//  that type and their entities.
+//
+//  Scripts that define OnCollisionBatch(contacts) are called once per
+//  script type with all collisions of a frame, after every OnCollision()
+//  call of that frame. Collisions dispatched one by one can't see damage
+//  dealt by batched scripts, so other scripts may still collide with
+//  entities that a batch kills later in the same frame. Batched scripts
+//  have to check if entities involved in their contacts are still alive.
 //
 
 class ScriptSystem
 {
+public:
+    // Type declarations.
+    struct CollisionBatch
+    {
+        CollisionBatch(const Lua::LuaRef& function) :
+            function(function),
+            contacts(Lua::LuaRef::newTable(function.state()))
+        {
+        }
+
+        Lua::LuaRef function;
+        Lua::LuaRef contacts;
+    };
+
+    typedef std::vector<CollisionBatch> CollisionBatchList;
+
+    struct UpdateBatch
+    {
+        UpdateBatch(const Lua::LuaRef& function, const void* identity) :
+            function(function),
+            identity(identity),
+            scripts(Lua::LuaRef::newTable(function.state())),
+            entities(Lua::LuaRef::newTable(function.state())),
+            count(0),
+            size(0)
+        {
+        }
+
+        Lua::LuaRef function;
+        const void* identity;
+        Lua::LuaRef scripts;
+        Lua::LuaRef entities;
+        int count;
+        int size;
+    };
+
+    typedef std::vector<UpdateBatch> UpdateBatchList;
+
 public:
     ScriptSystem();
     ~ScriptSystem();
@@ -26,11 +75,15 @@ public:
     void Update(float timeDelta);
 
 public:
-    void OnEntityCreatedEvent(const GameEvent::EntityCreated& event);
-    void OnEntityDestroyedEvent(const GameEvent::EntityDestroyed& event);
+    void OnEntitiesCreatedEvent(const GameEvent::EntitiesCreated& event);
+    void OnEntitiesDestroyedEvent(const GameEvent::EntitiesDestroyed& event);
     void OnEntityDamagedEvent(const GameEvent::EntityDamaged& event);
     void OnEntityHealedEvent(const GameEvent::EntityHealed& event);
     void OnEntityCollisionEvent(const GameEvent::EntityCollision& event);
+    void OnEntityCollisionBatchEvent(const GameEvent::EntityCollisionBatch& event);
+
+private:
+    void AddToUpdateBatch(const Lua::LuaRef& function, const Lua::LuaRef& script, const EntityHandle& entity);
 
 private:
     // System state.
@@ -42,9 +95,17 @@ private:
     ComponentSystem* m_componentSystem;
 
     // Event receivers.
-    Receiver<GameEvent::EntityCreated> m_receiverEntityCreated;
-    Receiver<GameEvent::EntityDestroyed> m_receiverEntityDestroyed;
+    Receiver<GameEvent::EntitiesCreated> m_receiverEntitiesCreated;
+    Receiver<GameEvent::EntitiesDestroyed> m_receiverEntitiesDestroyed;
     Receiver<GameEvent::EntityDamaged> m_receiverEntityDamaged;
     Receiver<GameEvent::EntityHealed> m_receiverEntityHealed;
     Receiver<GameEvent::EntityCollision> m_receiverEntityCollsion;
+    Receiver<GameEvent::EntityCollisionBatch> m_receiverEntityCollisionBatch;
+
+    // Collision batches of script types.
+    CollisionBatchList m_collisionBatches;
+
+    // Update batches of script types.
+    // Kept between updates to reuse their tables.
+    UpdateBatchList m_updateBatches;
 };
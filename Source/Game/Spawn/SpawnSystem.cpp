@@ -2,6 +2,9 @@
 #include "SpawnSystem.hpp"
 
 #include "MainGlobal.hpp"
+#include "Common/Services.hpp"
+#include "Scripting/LuaEngine.hpp"
+#include "Game/Prefab/PrefabSystem.hpp"
 
 namespace
 {
@@ -10,7 +13,8 @@ namespace
     std::mt19937 coordRandom(randomDevice());
 }
 
-SpawnSystem::SpawnSystem()
+SpawnSystem::SpawnSystem() :
+    m_prefabSystem(nullptr)
 {
 }
 
@@ -19,15 +23,21 @@ SpawnSystem::~SpawnSystem()
     Cleanup();
 }
 
-bool SpawnSystem::Initialize()
+bool SpawnSystem::Initialize(const Services& services)
 {
     Cleanup();
 
+    // Get required services.
+    m_prefabSystem = services.Get<PrefabSystem>();
+    if(m_prefabSystem == nullptr) return false;
+
     return true;
 }
 
 void SpawnSystem::Cleanup()
 {
+    m_prefabSystem = nullptr;
+
     m_spawnList.clear();
 }
 
@@ -54,26 +64,34 @@ void SpawnSystem::Update(float timeDelta)
             position.x = definition.area.x + std::uniform_real<float>(0.0f, size.x)(coordRandom);
             position.y = definition.area.y + std::uniform_real<float>(0.0f, size.y)(coordRandom);
 
-            // Call the spawn function.
-            try
+            if(definition.prefab != nullptr)
             {
-                definition.function(position);
+                // Instantiate the prefab natively.
+                m_prefabSystem->InstantiateAt(definition.prefab, position);
             }
-            catch(Lua::LuaException& exception)
+            else
             {
-                // Get the exception error text.
-                std::string error = exception.what();
-
-                // Remove base path to working directory.
-                std::size_t position = error.find(Main::GetWorkingDir());
-
-                if(position != std::string::npos)
+                // Call the spawn function.
+                try
                 {
-                    error.erase(position, Main::GetWorkingDir().size());
+                    definition.function(position);
                 }
+                catch(Lua::LuaException& exception)
+                {
+                    // Get the exception error text.
+                    std::string error = exception.what();
 
-                // Print the error.
-                Log() << "Lua error - " << error << ".";
+                    // Remove base path to working directory.
+                    std::size_t position = error.find(Main::GetWorkingDir());
+
+                    if(position != std::string::npos)
+                    {
+                        error.erase(position, Main::GetWorkingDir().size());
+                    }
+
+                    // Print the error.
+                    Log() << "Lua error - " << error << ".";
+                }
             }
 
             // Set a new spawn delay.
@@ -89,7 +107,7 @@ void SpawnSystem::AddSpawn(Lua::LuaRef function, const glm::vec4& area, float mi
         return;
 
     // Create a spawn definition.
-    SpawnDefinition definition(function, area, minDelay, maxDelay);
+    SpawnDefinition definition(function, nullptr, area, minDelay, maxDelay);
 
     // Roll the initial delay.
     definition.currentDelay = std::uniform_real<float>(minDelay, maxDelay)(spawnRandom);
@@ -102,3 +120,20 @@ void SpawnSystem::RemoveAllSpawns()
 {
     m_spawnList.clear();
 }
+
+void SpawnSystem::AddPrefabSpawn(EntityPrefab* prefab, const glm::vec4& area, float minDelay, float maxDelay)
+{
+    // Validate prefab.
+    if(prefab == nullptr)
+        return;
+
+    // Create a spawn definition without a function.
+    Lua::LuaRef function(Main::GetLuaEngine().GetState());
+    SpawnDefinition definition(function, prefab, area, minDelay, maxDelay);
+
+    // Roll the initial delay.
+    definition.currentDelay = std::uniform_real<float>(minDelay, maxDelay)(spawnRandom);
+
+    // Add a definition to the list.
+    m_spawnList.push_back(definition);
+}
@@ -2,6 +2,11 @@
 
 #include "Precompiled.hpp"
 
+// Forward declarations.
+class Services;
+class EntityPrefab;
+class PrefabSystem;
+
 //
 // Spawn System
 //
@@ -12,23 +17,25 @@ public:
     SpawnSystem();
     ~SpawnSystem();
 
-    bool Initialize();
+    bool Initialize(const Services& services);
     void Cleanup();
 
     void Update(float timeDelta);
 
     void AddSpawn(Lua::LuaRef function, const glm::vec4& area, float minDelay, float maxDelay);
+    void AddPrefabSpawn(EntityPrefab* prefab, const glm::vec4& area, float minDelay, float maxDelay);
     void RemoveAllSpawns();
 
 private:
     struct SpawnDefinition
     {
-        SpawnDefinition(Lua::LuaRef function, const glm::vec4& area, float minDelay, float maxDelay) :
-            function(function), area(area), minDelay(minDelay), maxDelay(maxDelay)
+        SpawnDefinition(Lua::LuaRef function, EntityPrefab* prefab, const glm::vec4& area, float minDelay, float maxDelay) :
+            function(function), prefab(prefab), area(area), minDelay(minDelay), maxDelay(maxDelay)
         {
         }
 
         Lua::LuaRef function;
+        EntityPrefab* prefab;
         glm::vec4 area;
         float minDelay;
         float maxDelay;
@@ -38,5 +45,9 @@ private:
     typedef std::vector<SpawnDefinition> SpawnList;
 
 private:
+    // Prefab system.
+    PrefabSystem* m_prefabSystem;
+
+    // List of spawn definitions.
     SpawnList m_spawnList;
 };
@@ -3,6 +3,22 @@
 #include "Precompiled.hpp"
 #include "Game/Component/Component.hpp"
 
+//
+// Transform Data
+//  Transform values with a plain layout that scripts can read and write
+//  directly through LuaJIT FFI. The layout must match the declaration
+//  in Data/Game/Common/ComponentData.lua.
+//
+
+struct TransformData
+{
+    glm::vec2 position;
+    glm::vec2 scale;
+    float rotation;
+};
+
+static_assert(sizeof(TransformData) == 5 * sizeof(float), "Unexpected transform data layout.");
+
 //
 // Transform Component
 //
@@ -22,52 +38,57 @@ public:
     // Sets the position.
     void SetPosition(const glm::vec2& position)
     {
-        m_position = position;
+        m_data.position = position;
     }
 
     // Sets the scale.
     void SetScale(const glm::vec2& scale)
     {
-        m_scale = scale;
+        m_data.scale = scale;
     }
 
     // Sets the rotation.
     void SetRotation(float rotation)
     {
-        m_rotation = glm::mod(rotation, 360.0f);
+        m_data.rotation = glm::mod(rotation, 360.0f);
     }
 
     // Gets the position.
     const glm::vec2& GetPosition() const
     {
-        return m_position;
+        return m_data.position;
     }
 
     glm::vec2 GetPositionCopy() const
     {
-        return m_position;
+        return m_data.position;
     }
 
     // Gets the scale.
     const glm::vec2& GetScale() const
     {
-        return m_scale;
+        return m_data.scale;
     }
 
     glm::vec2 GetScaleCopy() const
     {
-        return m_scale;
+        return m_data.scale;
     }
 
     // Gets the rotation.
     float GetRotation() const
     {
-        return m_rotation;
+        return m_data.rotation;
+    }
+
+    // Gets the transform data.
+    // Rotation written directly is not wrapped to 360 degrees.
+    TransformData& GetData()
+    {
+        return m_data;
     }
 
 private:
     // Transform data.
-    glm::vec2 m_position;
-    glm::vec2 m_scale;
-    float m_rotation;
+    TransformData m_data;
 };
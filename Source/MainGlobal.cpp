@@ -1,6 +1,7 @@
 #include "Precompiled.hpp"
 #include "MainGlobal.hpp"
 
+#include "Common/JobSystem.hpp"
 #include "Logger/Logger.hpp"
 #include "Logger/LoggerOutputFile.hpp"
 #include "Logger/LoggerOutputConsole.hpp"
@@ -53,6 +54,7 @@ namespace
     LoggerOutputFile    loggerOutputFile;
     LoggerOutputConsole loggerOutputConsole;
     CacheManager        cacheManager;
+    JobSystem           jobSystem;
     ConsoleSystem       consoleSystem;
     ConsoleHistory      consoleHistory;
     ConsoleFrame        consoleFrame;
@@ -200,6 +202,12 @@ bool Main::Initialize()
     if(!cacheManager.Initialize())
         return false;
 
+    // Initialize the job system.
+    if(!jobSystem.Initialize())
+        return false;
+
+    Log() << "Started " << jobSystem.GetWorkerCount() << " worker threads.";
+
     //
     // SDL
     //
@@ -490,6 +498,7 @@ void Main::Cleanup()
     // System
     //
 
+    jobSystem.Cleanup();
     cacheManager.Cleanup();
 
     //
@@ -574,6 +583,11 @@ CacheManager& Main::GetCacheManager()
     return cacheManager;
 }
 
+JobSystem& Main::GetJobSystem()
+{
+    return jobSystem;
+}
+
 ConsoleSystem& Main::GetConsoleSystem()
 {
     return consoleSystem;
@@ -5,6 +5,7 @@
 // Forward declarations.
 class Logger;
 class CacheManager;
+class JobSystem;
 class ConsoleSystem;
 class ConsoleHistory;
 class ConsoleFrame;
@@ -57,6 +58,7 @@ namespace Main
 
     Logger&         GetLogger();
     CacheManager&   GetCacheManager();
+    JobSystem&      GetJobSystem();
     ConsoleSystem&  GetConsoleSystem();
     ConsoleHistory& GetConsoleHistory();
     ConsoleFrame&   GetConsoleFrame();
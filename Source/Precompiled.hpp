@@ -21,6 +21,11 @@
 #include <map>
 #include <unordered_map>
 #include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 // Functions that have different names on different platforms.
 // Some of them are not included in C++ Standard, but are part of UNIX.
@@ -7,6 +7,8 @@
 #include "Game/Component/ComponentSystem.hpp"
 #include "Game/Identity/IdentitySystem.hpp"
 #include "Game/Transform/TransformComponent.hpp"
+#include "Game/Movement/VelocityComponent.hpp"
+#include "Game/Movement/MovementSystem.hpp"
 #include "Game/Input/InputComponent.hpp"
 #include "Game/Input/InputSystem.hpp"
 #include "Game/Health/HealthComponent.hpp"
@@ -17,8 +19,150 @@
 #include "Game/Script/ScriptSystem.hpp"
 #include "Game/Render/RenderComponent.hpp"
 #include "Game/Render/RenderSystem.hpp"
+#include "Game/Prefab/EntityPrefab.hpp"
+#include "Game/Prefab/PrefabSystem.hpp"
 #include "Game/Spawn/SpawnSystem.hpp"
 
+namespace luabridge
+{
+    // Pass collision shapes as integers.
+    template<>
+    struct Stack<CollisionShapes::Type>
+    {
+        static void push(lua_State* state, CollisionShapes::Type value)
+        {
+            lua_pushinteger(state, value);
+        }
+
+        static CollisionShapes::Type get(lua_State* state, int index)
+        {
+            return (CollisionShapes::Type)luaL_checkinteger(state, index);
+        }
+    };
+
+    // Pass transform data as light userdata for LuaJIT FFI.
+    template<>
+    struct Stack<TransformData*>
+    {
+        static void push(lua_State* state, TransformData* data)
+        {
+            if(data != nullptr)
+            {
+                lua_pushlightuserdata(state, data);
+            }
+            else
+            {
+                lua_pushnil(state);
+            }
+        }
+
+        static TransformData* get(lua_State* state, int index)
+        {
+            return static_cast<TransformData*>(lua_touserdata(state, index));
+        }
+    };
+
+    // Pass entity lists as arrays of handles.
+    template<>
+    struct Stack<EntitySystem::EntityList>
+    {
+        static void push(lua_State* state, const EntitySystem::EntityList& entities)
+        {
+            lua_createtable(state, (int)entities.size(), 0);
+
+            for(std::size_t i = 0; i < entities.size(); ++i)
+            {
+                Stack<EntityHandle>::push(state, entities[i]);
+                lua_rawseti(state, -2, (int)i + 1);
+            }
+        }
+
+        static EntitySystem::EntityList get(lua_State* state, int index)
+        {
+            luaL_checktype(state, index, LUA_TTABLE);
+
+            EntitySystem::EntityList entities;
+            entities.reserve(lua_objlen(state, index));
+
+            for(int i = 1; i <= (int)lua_objlen(state, index); ++i)
+            {
+                // Userdata must be read from an absolute stack index.
+                lua_rawgeti(state, index, i);
+                entities.push_back(Stack<EntityHandle>::get(state, lua_gettop(state)));
+                lua_pop(state, 1);
+            }
+
+            return entities;
+        }
+    };
+
+    // Pass component lists as arrays of components.
+    template<typename Type>
+    struct Stack<std::vector<Type*>>
+    {
+        static void push(lua_State* state, const std::vector<Type*>& components)
+        {
+            lua_createtable(state, (int)components.size(), 0);
+
+            for(std::size_t i = 0; i < components.size(); ++i)
+            {
+                Stack<Type*>::push(state, components[i]);
+                lua_rawseti(state, -2, (int)i + 1);
+            }
+        }
+    };
+}
+
+namespace
+{
+    // Proxy functions.
+    EntitySystem::EntityList CreateEntities(EntitySystem* entitySystem, int count)
+    {
+        EntitySystem::EntityList entities;
+        entitySystem->CreateEntities(count, entities);
+        return entities;
+    }
+
+    void DestroyEntities(EntitySystem* entitySystem, EntitySystem::EntityList entities)
+    {
+        entitySystem->DestroyEntities(entities);
+    }
+
+    EntitySystem::EntityList InstantiateMany(PrefabSystem* prefabSystem, EntityPrefab* prefab, int count)
+    {
+        EntitySystem::EntityList entities;
+        prefabSystem->InstantiateMany(prefab, count, entities);
+        return entities;
+    }
+
+    TransformData* LookupTransformData(ComponentSystem* componentSystem, EntityHandle entity)
+    {
+        TransformComponent* transform = componentSystem->Lookup<TransformComponent>(entity);
+        return transform != nullptr ? &transform->GetData() : nullptr;
+    }
+
+    std::vector<TransformData*> LookupTransformsData(ComponentSystem* componentSystem, EntitySystem::EntityList entities)
+    {
+        std::vector<TransformData*> data;
+        data.reserve(entities.size());
+
+        for(const EntityHandle& entity : entities)
+        {
+            data.push_back(LookupTransformData(componentSystem, entity));
+        }
+
+        return data;
+    }
+
+    template<typename Type>
+    std::vector<Type*> CreateComponents(ComponentSystem* componentSystem, EntitySystem::EntityList entities)
+    {
+        std::vector<Type*> components;
+        componentSystem->CreateBatch<Type>(entities, components);
+        return components;
+    }
+}
+
 bool BindLuaGame(LuaEngine& lua)
 {
     if(!lua.IsValid())
@@ -35,6 +179,16 @@ bool BindLuaGame(LuaEngine& lua)
                 .addFunction("SetRotation", &TransformComponent::SetRotation)
                 .addFunction("GetRotation", &TransformComponent::GetRotation)
             .endClass()
+            .beginClass<VelocityComponent>("VelocityComponent")
+                .addFunction("SetLinearVelocity", &VelocityComponent::SetLinearVelocity)
+                .addFunction("GetLinearVelocity", &VelocityComponent::GetLinearVelocityCopy)
+                .addFunction("SetAcceleration", &VelocityComponent::SetAcceleration)
+                .addFunction("GetAcceleration", &VelocityComponent::GetAccelerationCopy)
+                .addFunction("SetDamping", &VelocityComponent::SetDamping)
+                .addFunction("GetDamping", &VelocityComponent::GetDamping)
+                .addFunction("SetAngularVelocity", &VelocityComponent::SetAngularVelocity)
+                .addFunction("GetAngularVelocity", &VelocityComponent::GetAngularVelocity)
+            .endClass()
             .beginClass<InputComponent>("InputComponent")
                 .addFunction("SetStateReference", &InputComponent::SetStateReference)
                 .addFunction("GetStateReference", &InputComponent::GetStateReference)
@@ -50,6 +204,8 @@ bool BindLuaGame(LuaEngine& lua)
             .beginClass<CollisionComponent>("CollisionComponent")
                 .addFunction("SetBoundingBox", &CollisionComponent::SetBoundingBox)
                 .addFunction("GetBoundingBox", &CollisionComponent::GetBoundingBoxCopy)
+                .addFunction("SetShape", &CollisionComponent::SetShape)
+                .addFunction("GetShape", &CollisionComponent::GetShape)
                 .addFunction("SetType", &CollisionComponent::SetType)
                 .addFunction("GetType", &CollisionComponent::GetType)
                 .addFunction("SetMask", &CollisionComponent::SetMask)
@@ -78,22 +234,35 @@ bool BindLuaGame(LuaEngine& lua)
             .endClass()
             .beginClass<EntitySystem>("EntitySystem")
                 .addFunction("CreateEntity", &EntitySystem::CreateEntity)
+                .addFunctionProxy("CreateEntities", &CreateEntities)
                 .addFunction("DestroyEntity", &EntitySystem::DestroyEntity)
+                .addFunctionProxy("DestroyEntities", &DestroyEntities)
                 .addFunction("IsHandleValid", &EntitySystem::IsHandleValid)
             .endClass()
             .beginClass<ComponentSystem>("ComponentSystem")
                 .addFunction("CreateTransform", &ComponentSystem::Create<TransformComponent>)
+                .addFunction("CreateVelocity", &ComponentSystem::Create<VelocityComponent>)
                 .addFunction("CreateInput", &ComponentSystem::Create<InputComponent>)
                 .addFunction("CreateHealth", &ComponentSystem::Create<HealthComponent>)
                 .addFunction("CreateCollision", &ComponentSystem::Create<CollisionComponent>)
                 .addFunction("CreateScript", &ComponentSystem::Create<ScriptComponent>)
                 .addFunction("CreateRender", &ComponentSystem::Create<RenderComponent>)
+                .addFunctionProxy("CreateTransforms", &CreateComponents<TransformComponent>)
+                .addFunctionProxy("CreateVelocities", &CreateComponents<VelocityComponent>)
+                .addFunctionProxy("CreateInputs", &CreateComponents<InputComponent>)
+                .addFunctionProxy("CreateHealths", &CreateComponents<HealthComponent>)
+                .addFunctionProxy("CreateCollisions", &CreateComponents<CollisionComponent>)
+                .addFunctionProxy("CreateScripts", &CreateComponents<ScriptComponent>)
+                .addFunctionProxy("CreateRenders", &CreateComponents<RenderComponent>)
                 .addFunction("LookupTransform", &ComponentSystem::Lookup<TransformComponent>)
+                .addFunction("LookupVelocity", &ComponentSystem::Lookup<VelocityComponent>)
                 .addFunction("LookupInput", &ComponentSystem::Lookup<InputComponent>)
                 .addFunction("LookupHealth", &ComponentSystem::Lookup<HealthComponent>)
                 .addFunction("LookupCollision", &ComponentSystem::Lookup<CollisionComponent>)
                 .addFunction("LookupScript", &ComponentSystem::Lookup<ScriptComponent>)
                 .addFunction("LookupRender", &ComponentSystem::Lookup<RenderComponent>)
+                .addFunctionProxy("LookupTransformData", &LookupTransformData)
+                .addFunctionProxy("LookupTransformsData", &LookupTransformsData)
             .endClass()
             .beginClass<IdentitySystem>("IdentitySystem")
                 .addFunction("SetEntityName", &IdentitySystem::SetEntityName)
@@ -109,6 +278,7 @@ bool BindLuaGame(LuaEngine& lua)
             .beginClass<HealthSystem>("HealthSystem")
                 .addFunction("Damage", &HealthSystem::Damage)
                 .addFunction("Heal", &HealthSystem::Heal)
+                .addFunction("IsAlive", &HealthSystem::IsAlive)
             .endClass()
             .beginClass<CollisionObject>("CollisionObject")
                 .addData("entity", &CollisionObject::entity, false)
@@ -122,10 +292,36 @@ bool BindLuaGame(LuaEngine& lua)
             .endClass()
             .beginClass<ScriptSystem>("ScriptSystem")
             .endClass()
+            .beginClass<MovementSystem>("MovementSystem")
+            .endClass()
             .beginClass<RenderSystem>("RenderSystem")
             .endClass()
+            .beginClass<EntityPrefab>("EntityPrefab")
+                .addFunction("CreateTransform", &EntityPrefab::Add<TransformComponent>)
+                .addFunction("CreateVelocity", &EntityPrefab::Add<VelocityComponent>)
+                .addFunction("CreateInput", &EntityPrefab::Add<InputComponent>)
+                .addFunction("CreateHealth", &EntityPrefab::Add<HealthComponent>)
+                .addFunction("CreateCollision", &EntityPrefab::Add<CollisionComponent>)
+                .addFunction("CreateScript", &EntityPrefab::Add<ScriptComponent>)
+                .addFunction("CreateRender", &EntityPrefab::Add<RenderComponent>)
+                .addFunction("LookupTransform", &EntityPrefab::Lookup<TransformComponent>)
+                .addFunction("LookupVelocity", &EntityPrefab::Lookup<VelocityComponent>)
+                .addFunction("LookupInput", &EntityPrefab::Lookup<InputComponent>)
+                .addFunction("LookupHealth", &EntityPrefab::Lookup<HealthComponent>)
+                .addFunction("LookupCollision", &EntityPrefab::Lookup<CollisionComponent>)
+                .addFunction("LookupScript", &EntityPrefab::Lookup<ScriptComponent>)
+                .addFunction("LookupRender", &EntityPrefab::Lookup<RenderComponent>)
+            .endClass()
+            .beginClass<PrefabSystem>("PrefabSystem")
+                .addFunction("CreatePrefab", &PrefabSystem::CreatePrefab)
+                .addFunction("GetPrefab", &PrefabSystem::GetPrefab)
+                .addFunction("Instantiate", &PrefabSystem::Instantiate)
+                .addFunction("InstantiateAt", &PrefabSystem::InstantiateAt)
+                .addFunctionProxy("InstantiateMany", &InstantiateMany)
+            .endClass()
             .beginClass<SpawnSystem>("SpawnSystem")
                 .addFunction("AddSpawn", &SpawnSystem::AddSpawn)
+                .addFunction("AddPrefabSpawn", &SpawnSystem::AddPrefabSpawn)
             .endClass()
             .beginClass<GameState>("GameState")
                 .addConstructor<void(*)(void)>()
@@ -142,10 +338,19 @@ bool BindLuaGame(LuaEngine& lua)
     collisionFlags["None"] = (uint32_t)CollisionFlags::None;
     collisionFlags["Enabled"] = (uint32_t)CollisionFlags::Enabled;
     collisionFlags["Reversed"] = (uint32_t)CollisionFlags::Reversed;
+    collisionFlags["FastMoving"] = (uint32_t)CollisionFlags::FastMoving;
     collisionFlags["Default"] = (uint32_t)CollisionFlags::Default;
 
     collisionFlags.push(lua.GetState());
     lua_setglobal(lua.GetState(), "CollisionFlags");
 
+    Lua::LuaRef collisionShapes(lua.GetState());
+    collisionShapes = Lua::newTable(lua.GetState());
+    collisionShapes["Box"] = (int)CollisionShapes::Box;
+    collisionShapes["Circle"] = (int)CollisionShapes::Circle;
+
+    collisionShapes.push(lua.GetState());
+    lua_setglobal(lua.GetState(), "CollisionShapes");
+
     return true;
 }
@@ -0,0 +1,195 @@
+#include "Precompiled.hpp"
+#include "Test.hpp"
+
+#include "Common/JobSystem.hpp"
+#include "Game/Collision/BoundingBoxBatch.hpp"
+#include "Game/Collision/SweepAndPrune.hpp"
+#include "Game/Collision/CollisionComponent.hpp"
+
+namespace
+{
+    // Scalar test that the batch has to match.
+    bool Intersects(const glm::vec4& a, const glm::vec4& b)
+    {
+        return !(a.x > b.z || a.z < b.x || a.y > b.w || a.w < b.y);
+    }
+
+    // Creates a box with coordinates on a small grid, so edges often touch.
+    glm::vec4 CreateBox(std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> coordinate(-10, 10);
+        std::uniform_int_distribution<int> size(0, 5);
+
+        glm::vec4 box((float)coordinate(random), (float)coordinate(random), 0.0f, 0.0f);
+        box.z = box.x + size(random);
+        box.w = box.y + size(random);
+
+        return box;
+    }
+
+    void TestIntersect()
+    {
+        std::mt19937 random(9);
+
+        for(int run = 0; run < 2000; ++run)
+        {
+            // Create a batch with a count that often isn't a multiple of the width.
+            int count = 1 + random() % 13;
+
+            std::vector<glm::vec4> boxes;
+            BoundingBoxBatch batch;
+
+            for(int i = 0; i < count; ++i)
+            {
+                boxes.push_back(CreateBox(random));
+                batch.Add(boxes.back());
+            }
+
+            batch.Finalize();
+
+            // Compare against scalar tests at every index, including
+            // the ones where the batch reads padding past the last box.
+            glm::vec4 box = CreateBox(random);
+
+            for(int index = 0; index < count; ++index)
+            {
+                uint32_t expected = 0;
+
+                for(int i = 0; i < BoundingBoxBatch::Width; ++i)
+                {
+                    if(index + i < count && Intersects(box, boxes[index + i]))
+                    {
+                        expected |= 1 << i;
+                    }
+                }
+
+                TEST_CHECK(batch.Intersect(box, index) == expected);
+            }
+        }
+    }
+
+    void TestPadding()
+    {
+        // Padding must not intersect even the largest finite box.
+        const float largest = std::numeric_limits<float>::max();
+        const glm::vec4 everything(-largest, -largest, largest, largest);
+
+        BoundingBoxBatch batch;
+        batch.Add(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+        batch.Finalize();
+
+        TEST_CHECK(batch.Intersect(everything, 0) == 1);
+
+        // Padding has to begin past any box, so the sweep stops at the end.
+        for(int i = 1; i < BoundingBoxBatch::Width + 1; ++i)
+        {
+            TEST_CHECK(batch.GetMinX(i) > largest);
+        }
+
+        // Batch can be reused after padding.
+        batch.Clear();
+        batch.Add(glm::vec4(2.0f, 2.0f, 3.0f, 3.0f));
+        batch.Add(glm::vec4(4.0f, 4.0f, 5.0f, 5.0f));
+        batch.Finalize();
+
+        TEST_CHECK(batch.GetCount() == 2);
+        TEST_CHECK(batch.Intersect(everything, 0) == 3);
+        TEST_CHECK(batch.Intersect(everything, 1) == 1);
+    }
+
+    // Finds pairs with the sweep and compares them against testing every pair.
+    // Returns the number of pairs found.
+    int CheckSweepAndPrune(const std::vector<glm::vec4>& boxes, const std::vector<CollisionComponent>& collisions, JobSystem* jobSystem)
+    {
+        CollisionBroadPhase::ObjectList objects(boxes.size());
+
+        for(unsigned int i = 0; i < boxes.size(); ++i)
+        {
+            objects[i].collision = const_cast<CollisionComponent*>(&collisions[i]);
+            objects[i].worldAABB = boxes[i];
+            objects[i].sweptAABB = boxes[i];
+            objects[i].enabled = true;
+        }
+
+        CollisionBroadPhase::PairList expected;
+
+        for(int a = 0; a < (int)boxes.size(); ++a)
+        {
+            for(int b = a + 1; b < (int)boxes.size(); ++b)
+            {
+                bool masked = (collisions[a].GetMask() & collisions[b].GetType()) || (collisions[b].GetMask() & collisions[a].GetType());
+
+                if(masked && Intersects(boxes[a], boxes[b]))
+                {
+                    expected.push_back(CollisionBroadPhase::ObjectPair(a, b));
+                }
+            }
+        }
+
+        SweepAndPrune sweepAndPrune;
+        CollisionBroadPhase::PairList pairs;
+        sweepAndPrune.FindPairs(objects, pairs, jobSystem);
+
+        std::sort(pairs.begin(), pairs.end());
+
+        TEST_CHECK(pairs == expected);
+
+        return (int)pairs.size();
+    }
+
+    void TestSweepAndPrune()
+    {
+        JobSystem jobSystem;
+        TEST_CHECK(jobSystem.Initialize(2));
+
+        // Stop the sweep on the minimum of the last box in a batch,
+        // while earlier boxes of the same batch still overlap.
+        {
+            std::vector<glm::vec4> boxes;
+            boxes.push_back(glm::vec4(0.0f, 0.0f, 10.0f, 10.0f));
+            boxes.push_back(glm::vec4(5.0f, 0.0f, 6.0f, 1.0f));
+            boxes.push_back(glm::vec4(7.0f, 0.0f, 8.0f, 1.0f));
+            boxes.push_back(glm::vec4(10.0f, 0.0f, 11.0f, 1.0f));
+            boxes.push_back(glm::vec4(11.0f, 0.0f, 12.0f, 1.0f));
+            boxes.push_back(glm::vec4(12.0f, 0.0f, 13.0f, 1.0f));
+
+            std::vector<CollisionComponent> collisions(boxes.size());
+
+            for(CollisionComponent& collision : collisions)
+            {
+                collision.SetType(1);
+                collision.SetMask(1);
+            }
+
+            TEST_CHECK(CheckSweepAndPrune(boxes, collisions, nullptr) == 5);
+        }
+
+        // Compare random scenes with different counts and collision bits.
+        std::mt19937 random(6);
+        std::uniform_int_distribution<int> bits(0, 3);
+
+        for(int run = 0; run < 300; ++run)
+        {
+            int count = 1 + random() % 600;
+
+            std::vector<glm::vec4> boxes(count);
+            std::vector<CollisionComponent> collisions(count);
+
+            for(int i = 0; i < count; ++i)
+            {
+                boxes[i] = CreateBox(random) * 4.0f;
+                collisions[i].SetType(bits(random));
+                collisions[i].SetMask(bits(random));
+            }
+
+            CheckSweepAndPrune(boxes, collisions, run % 2 ? &jobSystem : nullptr);
+        }
+    }
+}
+
+void TestBoundingBoxBatch()
+{
+    TestIntersect();
+    TestPadding();
+    TestSweepAndPrune();
+}
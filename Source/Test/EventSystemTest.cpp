@@ -0,0 +1,214 @@
+#include "Precompiled.hpp"
+#include "Test.hpp"
+
+#include "Game/Event/EventSystem.hpp"
+
+namespace
+{
+    // Events of different types and sizes.
+    struct SmallEvent
+    {
+        int source;
+        int value;
+    };
+
+    struct OtherEvent
+    {
+        int source;
+        int value;
+    };
+
+    struct LargeEvent
+    {
+        int source;
+        int value;
+        char data[256];
+    };
+
+    // Records received events in the order they arrived.
+    class Recorder
+    {
+    public:
+        struct Record
+        {
+            int type;
+            int source;
+            int value;
+        };
+
+    public:
+        Recorder(EventSystem& eventSystem) :
+            m_eventSystem(eventSystem),
+            m_requeue(false)
+        {
+            m_receiverSmall.Bind<Recorder, &Recorder::OnSmallEvent>(this);
+            m_receiverOther.Bind<Recorder, &Recorder::OnOtherEvent>(this);
+            m_receiverLarge.Bind<Recorder, &Recorder::OnLargeEvent>(this);
+
+            m_eventSystem.Subscribe(m_receiverSmall);
+            m_eventSystem.Subscribe(m_receiverOther);
+            m_eventSystem.Subscribe(m_receiverLarge);
+        }
+
+        void OnSmallEvent(const SmallEvent& event)
+        {
+            m_records.push_back(Record{ 0, event.source, event.value });
+
+            // Queue another event while flushing.
+            if(m_requeue)
+            {
+                m_requeue = false;
+
+                OtherEvent other = { event.source, -1 };
+                m_eventSystem.Queue(other);
+            }
+        }
+
+        void OnOtherEvent(const OtherEvent& event)
+        {
+            m_records.push_back(Record{ 1, event.source, event.value });
+        }
+
+        void OnLargeEvent(const LargeEvent& event)
+        {
+            m_records.push_back(Record{ 2, event.source, event.value });
+        }
+
+    public:
+        EventSystem& m_eventSystem;
+        std::vector<Record> m_records;
+        bool m_requeue;
+
+    private:
+        Receiver<SmallEvent> m_receiverSmall;
+        Receiver<OtherEvent> m_receiverOther;
+        Receiver<LargeEvent> m_receiverLarge;
+    };
+
+    // Queues an event of a type chosen by its value.
+    void QueueEvent(EventSystem& eventSystem, int source, int value)
+    {
+        switch(value % 3)
+        {
+        case 0:
+            {
+                SmallEvent event = { source, value };
+                eventSystem.Queue(event);
+            }
+            break;
+
+        case 1:
+            {
+                OtherEvent event = { source, value };
+                eventSystem.Queue(event);
+            }
+            break;
+
+        case 2:
+            {
+                LargeEvent event = { source, value };
+                eventSystem.Queue(event);
+            }
+            break;
+        }
+    }
+
+    void TestQueueOrder()
+    {
+        EventSystem eventSystem;
+        TEST_CHECK(eventSystem.Initialize());
+
+        Recorder recorder(eventSystem);
+
+        // Events of all types are sent in the order they were queued.
+        const int Values[] = { 0, 3, 1, 2, 5, 6, 4 };
+
+        for(int value : Values)
+        {
+            QueueEvent(eventSystem, 0, value);
+        }
+
+        recorder.m_requeue = true;
+        eventSystem.Flush();
+
+        TEST_CHECK(recorder.m_records.size() == 7);
+
+        for(std::size_t i = 0; i < recorder.m_records.size() && i < 7; ++i)
+        {
+            TEST_CHECK(recorder.m_records[i].value == Values[i]);
+            TEST_CHECK(recorder.m_records[i].type == Values[i] % 3);
+        }
+
+        // Events queued while flushing wait for the next flush.
+        recorder.m_records.clear();
+        eventSystem.Flush();
+
+        TEST_CHECK(recorder.m_records.size() == 1);
+        TEST_CHECK(recorder.m_records.size() == 1 && recorder.m_records[0].value == -1);
+    }
+
+    void TestQueueFromThreads()
+    {
+        EventSystem eventSystem;
+        TEST_CHECK(eventSystem.Initialize());
+
+        Recorder recorder(eventSystem);
+
+        // Queue events of all types from several threads while flushing.
+        const int ThreadCount = 4;
+        const int EventCount = 5000;
+
+        for(int round = 0; round < 3; ++round)
+        {
+            recorder.m_records.clear();
+
+            std::atomic<int> finished(0);
+            std::vector<std::thread> threads;
+
+            for(int source = 0; source < ThreadCount; ++source)
+            {
+                threads.emplace_back([&, source]()
+                {
+                    for(int value = 0; value < EventCount; ++value)
+                    {
+                        QueueEvent(eventSystem, source, value);
+                    }
+
+                    finished += 1;
+                });
+            }
+
+            while(finished < ThreadCount)
+            {
+                eventSystem.Flush();
+            }
+
+            for(std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            eventSystem.Flush();
+
+            // Check that every event arrived once and in the order each thread queued it.
+            TEST_CHECK(recorder.m_records.size() == ThreadCount * EventCount);
+
+            std::vector<int> expected(ThreadCount, 0);
+            bool ordered = true;
+
+            for(const Recorder::Record& record : recorder.m_records)
+            {
+                ordered = ordered && record.value == expected[record.source] && record.type == record.value % 3;
+                expected[record.source] += 1;
+            }
+
+            TEST_CHECK(ordered);
+        }
+    }
+}
+
+void TestEventSystem()
+{
+    TestQueueOrder();
+    TestQueueFromThreads();
+}
@@ -0,0 +1,209 @@
+#include "Precompiled.hpp"
+#include "Test.hpp"
+
+#include "Common/JobSystem.hpp"
+
+namespace
+{
+    // Number of workers used by tests, independent of the machine.
+    const int WorkerCount = 4;
+
+    // Keeps a thread busy without sleeping, so other workers get a chance to steal.
+    void Spin(std::chrono::microseconds duration)
+    {
+        auto end = std::chrono::steady_clock::now() + duration;
+
+        while(std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+
+    void TestInlineExecution()
+    {
+        JobSystem jobSystem;
+        TEST_CHECK(jobSystem.Initialize(0));
+
+        // Jobs run in place without workers.
+        JobCounter counter(0);
+        int value = 0;
+
+        jobSystem.Submit([&value]() { value = 1; }, &counter);
+
+        TEST_CHECK(value == 1);
+        TEST_CHECK(counter == 0);
+    }
+
+    void TestSubmitFromThreads()
+    {
+        JobSystem jobSystem;
+        TEST_CHECK(jobSystem.Initialize(WorkerCount));
+
+        // Submit and wait for jobs from several threads at once.
+        const int ThreadCount = 8;
+        const int JobCount = 2000;
+
+        std::atomic<int> executed(0);
+        std::vector<std::thread> threads;
+
+        for(int i = 0; i < ThreadCount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                JobCounter counter(0);
+
+                for(int j = 0; j < JobCount; ++j)
+                {
+                    jobSystem.Submit([&executed]() { executed += 1; }, &counter);
+                }
+
+                jobSystem.Wait(counter);
+
+                TEST_CHECK(counter == 0);
+            });
+        }
+
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        TEST_CHECK(executed == ThreadCount * JobCount);
+    }
+
+    void TestNestedJobs()
+    {
+        JobSystem jobSystem;
+        TEST_CHECK(jobSystem.Initialize(WorkerCount));
+
+        // Submit jobs from jobs and wait for them on worker threads.
+        const int ParentCount = 64;
+        const int ChildCount = 64;
+
+        std::atomic<int> executed(0);
+        JobCounter counter(0);
+
+        for(int i = 0; i < ParentCount; ++i)
+        {
+            jobSystem.Submit([&]()
+            {
+                JobCounter children(0);
+
+                for(int j = 0; j < ChildCount; ++j)
+                {
+                    jobSystem.Submit([&executed]() { executed += 1; }, &children);
+                }
+
+                jobSystem.Wait(children);
+
+                TEST_CHECK(children == 0);
+            }, &counter);
+        }
+
+        jobSystem.Wait(counter);
+
+        TEST_CHECK(executed == ParentCount * ChildCount);
+    }
+
+    void TestStealing()
+    {
+        JobSystem jobSystem;
+        TEST_CHECK(jobSystem.Initialize(WorkerCount));
+
+        // Fill the queue of a single worker and let others steal from it.
+        const int JobCount = 256;
+
+        std::mutex mutex;
+        std::vector<std::thread::id> threadIds;
+        JobCounter counter(0);
+
+        jobSystem.Submit([&]()
+        {
+            JobCounter jobs(0);
+
+            for(int i = 0; i < JobCount; ++i)
+            {
+                jobSystem.Submit([&]()
+                {
+                    Spin(std::chrono::microseconds(200));
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    threadIds.push_back(std::this_thread::get_id());
+                }, &jobs);
+            }
+
+            jobSystem.Wait(jobs);
+        }, &counter);
+
+        jobSystem.Wait(counter);
+
+        // Check that every job ran once and more than one thread took part.
+        TEST_CHECK(threadIds.size() == JobCount);
+
+        std::sort(threadIds.begin(), threadIds.end());
+        threadIds.erase(std::unique(threadIds.begin(), threadIds.end()), threadIds.end());
+
+        TEST_CHECK(threadIds.size() > 1);
+    }
+
+    void TestParallelFor()
+    {
+        JobSystem jobSystem;
+        TEST_CHECK(jobSystem.Initialize(WorkerCount));
+
+        // Process every index of a range exactly once.
+        const int Count = 100000;
+
+        std::vector<std::atomic<int>> visits(Count);
+
+        for(std::atomic<int>& visit : visits)
+        {
+            visit = 0;
+        }
+
+        jobSystem.ParallelFor(0, Count, 64, [&visits](int begin, int end)
+        {
+            for(int i = begin; i < end; ++i)
+            {
+                visits[i] += 1;
+            }
+        });
+
+        bool visitedOnce = std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& visit)
+        {
+            return visit == 1;
+        });
+
+        TEST_CHECK(visitedOnce);
+    }
+
+    void TestCleanupFinishesJobs()
+    {
+        // Repeatedly stop workers with jobs still in queues.
+        for(int i = 0; i < 50; ++i)
+        {
+            JobSystem jobSystem;
+            TEST_CHECK(jobSystem.Initialize(WorkerCount));
+
+            std::atomic<int> executed(0);
+
+            for(int j = 0; j < 100; ++j)
+            {
+                jobSystem.Submit([&executed]() { executed += 1; });
+            }
+
+            jobSystem.Cleanup();
+
+            TEST_CHECK(executed == 100);
+        }
+    }
+}
+
+void TestJobSystem()
+{
+    TestInlineExecution();
+    TestSubmitFromThreads();
+    TestNestedJobs();
+    TestStealing();
+    TestParallelFor();
+    TestCleanupFinishesJobs();
+}
@@ -0,0 +1,28 @@
+#include "Precompiled.hpp"
+#include "Test.hpp"
+
+namespace
+{
+    // Number of failed checks.
+    std::atomic<int> failures(0);
+
+    // Serializes output of checks failed on different threads.
+    std::mutex outputMutex;
+}
+
+void Test::Check(bool result, const char* expression, const char* file, int line)
+{
+    if(result)
+        return;
+
+    failures += 1;
+
+    // Print the failed check.
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << file << "(" << line << "): Check failed: " << expression << std::endl;
+}
+
+int Test::GetFailureCount()
+{
+    return failures;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Precompiled.hpp"
+
+//
+// Test
+//  Helpers shared by test suites. Failed checks are printed with their
+//  location and make the test executable return a non-zero exit code.
+//
+//  Example usage:
+//      TEST_CHECK(pool.GetCount() == 1);
+//
+
+namespace Test
+{
+    // Records the result of a check. Can be called from any thread.
+    void Check(bool result, const char* expression, const char* file, int line);
+
+    // Returns the number of failed checks.
+    int GetFailureCount();
+}
+
+// Checks if an expression is true.
+#define TEST_CHECK(expression) Test::Check((expression), #expression, __FILE__, __LINE__)
+
+// Test suites.
+void TestJobSystem();
+void TestBoundingBoxBatch();
+void TestEventSystem();
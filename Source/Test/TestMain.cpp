@@ -0,0 +1,37 @@
+#include "Precompiled.hpp"
+#include "Test.hpp"
+
+namespace
+{
+    // List of test suites.
+    struct Suite
+    {
+        const char* name;
+        void (*function)();
+    };
+
+    const Suite Suites[] =
+    {
+        { "JobSystem", &TestJobSystem },
+        { "BoundingBoxBatch", &TestBoundingBoxBatch },
+        { "EventSystem", &TestEventSystem },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    // Run suites named on the command line or all of them.
+    for(const Suite& suite : Suites)
+    {
+        if(argc > 1 && std::find(argv + 1, argv + argc, std::string(suite.name)) == argv + argc)
+            continue;
+
+        int failures = Test::GetFailureCount();
+
+        suite.function();
+
+        std::cout << suite.name << ": " << (Test::GetFailureCount() == failures ? "Passed" : "Failed") << std::endl;
+    }
+
+    return Test::GetFailureCount() == 0 ? 0 : 1;
+}